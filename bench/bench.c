@@ -0,0 +1,320 @@
+/******************************************************************************/
+/**
+ * \file  bench.c
+ *
+ * \brief Micro-benchmarks for tiny_rb: single-op and bulk throughput,
+ *        per-op latency percentiles and SPSC cross-core handoff.
+ *        Results are printed as one JSON object per line so runs can be
+ *        diffed or collected across releases.
+ *
+ *        Usage: bench [iterations]
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tiny_rb.h"
+#include "tiny_rb_spsc.h"
+
+#define BENCH_BULK      32
+#define BENCH_SAMPLES   100000
+
+typedef struct { uint32_t v; } elem4_t;
+typedef struct { uint32_t v; unsigned char pad[60]; } elem64_t;
+typedef struct { uint32_t v; unsigned char pad[252]; } elem256_t;
+
+static volatile uint32_t bench_sink;
+static long bench_ncpu;
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Back off in a spin loop; yield when there is no second core to wait for */
+static void bench_relax(void)
+{
+    if (bench_ncpu < 2) {
+        sched_yield();
+    } else {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+static void bench_pin(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (bench_ncpu < 2) {
+        return;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu % bench_ncpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+static void report_rate(const char *bench, const char *variant, size_t esize,
+                        size_t cap, size_t ops, uint64_t ns)
+{
+    double ns_per_op = (double)ns / (double)ops;
+
+    printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"elem_size\":%zu,\"capacity\":%zu,"
+           "\"ops\":%zu,\"ns_per_op\":%.3f,\"mops_per_s\":%.3f}\n",
+           bench, variant, esize, cap, ops, ns_per_op, 1e3 / ns_per_op);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void report_latency(const char *bench, const char *variant, size_t esize,
+                           size_t cap, uint32_t *lat, size_t n)
+{
+    qsort(lat, n, sizeof(lat[0]), cmp_u32);
+    printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"elem_size\":%zu,\"capacity\":%zu,"
+           "\"samples\":%zu,\"p50_ns\":%u,\"p99_ns\":%u,\"p999_ns\":%u}\n",
+           bench, variant, esize, cap, n,
+           lat[n / 2], lat[n * 99 / 100], lat[n * 999 / 1000]);
+}
+
+static uint32_t bench_lat[BENCH_SAMPLES];
+
+/*
+ * Single-threaded benchmarks for one element size and capacity. The buffer is
+ * kept half full so push and pop touch different slots and both wrap.
+ */
+#define BENCH_LOCAL(SZ, CAP)\
+    TRB_RB_DEFINE_STATIC(elem##SZ##_t, fifo_##SZ##_##CAP, CAP);\
+    TRB_RB_DEFINE_POW2_STATIC(elem##SZ##_t, pow2_##SZ##_##CAP, CAP);\
+    static void bench_local_##SZ##_##CAP(size_t iters)\
+    {\
+        static elem##SZ##_t blk[BENCH_BULK];\
+        elem##SZ##_t v = {0};\
+        uint32_t sum = 0;\
+        uint64_t t0;\
+        size_t i;\
+        \
+        for (i = 0; i < (CAP) / 2; i++) {\
+            trb_fifo_push(fifo_##SZ##_##CAP, &v);\
+            trb_pow2_fifo_push(pow2_##SZ##_##CAP, &v);\
+        }\
+        \
+        t0 = bench_now_ns();\
+        for (i = 0; i < iters; i++) {\
+            v.v = (uint32_t)i;\
+            trb_fifo_push(fifo_##SZ##_##CAP, &v);\
+            trb_fifo_pop(fifo_##SZ##_##CAP, &v);\
+            sum += v.v;\
+        }\
+        report_rate("single", "fifo", SZ, CAP, iters, bench_now_ns() - t0);\
+        \
+        t0 = bench_now_ns();\
+        for (i = 0; i < iters; i++) {\
+            v.v = (uint32_t)i;\
+            trb_pow2_fifo_push(pow2_##SZ##_##CAP, &v);\
+            trb_pow2_fifo_pop(pow2_##SZ##_##CAP, &v);\
+            sum += v.v;\
+        }\
+        report_rate("single", "pow2", SZ, CAP, iters, bench_now_ns() - t0);\
+        \
+        if (BENCH_BULK <= (CAP) / 2) {\
+            t0 = bench_now_ns();\
+            for (i = 0; i < iters / BENCH_BULK; i++) {\
+                blk[0].v = (uint32_t)i;\
+                trb_fifo_push_n(fifo_##SZ##_##CAP, blk, BENCH_BULK);\
+                trb_fifo_pop_n(fifo_##SZ##_##CAP, blk, BENCH_BULK);\
+                sum += blk[0].v;\
+            }\
+            report_rate("bulk", "fifo", SZ, CAP, i * BENCH_BULK, bench_now_ns() - t0);\
+        }\
+        \
+        for (i = 0; i < BENCH_SAMPLES; i++) {\
+            t0 = bench_now_ns();\
+            trb_fifo_push(fifo_##SZ##_##CAP, &v);\
+            trb_fifo_pop(fifo_##SZ##_##CAP, &v);\
+            bench_lat[i] = (uint32_t)(bench_now_ns() - t0);\
+        }\
+        report_latency("latency", "fifo", SZ, CAP, bench_lat, BENCH_SAMPLES);\
+        \
+        bench_sink = sum;\
+    }
+
+BENCH_LOCAL(4, 64)
+BENCH_LOCAL(4, 4096)
+BENCH_LOCAL(64, 64)
+BENCH_LOCAL(64, 4096)
+BENCH_LOCAL(256, 64)
+BENCH_LOCAL(256, 4096)
+
+#define BENCH_SPSC_CAP 1024
+
+/*
+ * Cross-thread benchmarks: streaming throughput with per-element and
+ * batched (trb_spsc_push_local) publication, and a ping-pong
+ * between two SPSC buffers whose round trip is halved to get the one-way
+ * handoff latency.
+ */
+#define BENCH_SPSC(SZ)\
+    TRB_SPSC_DEFINE_STATIC(elem##SZ##_t, spsc_##SZ, BENCH_SPSC_CAP);\
+    TRB_SPSC_DEFINE_STATIC(elem##SZ##_t, pong_##SZ, BENCH_SPSC_CAP);\
+    static size_t spsc_iters_##SZ;\
+    static void *spsc_stream_##SZ(void *arg)\
+    {\
+        elem##SZ##_t v = {0};\
+        size_t i;\
+        \
+        (void)arg;\
+        bench_pin(1);\
+        for (i = 0; i < spsc_iters_##SZ; i++) {\
+            v.v = (uint32_t)i;\
+            while (trb_spsc_push(spsc_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+        }\
+        return NULL;\
+    }\
+    static void *spsc_batch_##SZ(void *arg)\
+    {\
+        elem##SZ##_t v = {0};\
+        size_t i;\
+        \
+        (void)arg;\
+        bench_pin(1);\
+        for (i = 0; i < spsc_iters_##SZ; i++) {\
+            v.v = (uint32_t)i;\
+            while (trb_spsc_push_local(spsc_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+        }\
+        trb_spsc_flush(spsc_##SZ);\
+        return NULL;\
+    }\
+    static void *spsc_echo_##SZ(void *arg)\
+    {\
+        elem##SZ##_t v;\
+        size_t i;\
+        \
+        (void)arg;\
+        bench_pin(1);\
+        for (i = 0; i < BENCH_SAMPLES; i++) {\
+            while (trb_spsc_pop(spsc_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+            while (trb_spsc_push(pong_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+        }\
+        return NULL;\
+    }\
+    static void bench_spsc_##SZ(size_t iters)\
+    {\
+        elem##SZ##_t v = {0};\
+        uint32_t sum = 0;\
+        pthread_t thr;\
+        uint64_t t0;\
+        size_t i;\
+        \
+        spsc_iters_##SZ = iters;\
+        bench_pin(0);\
+        t0 = bench_now_ns();\
+        pthread_create(&thr, NULL, spsc_stream_##SZ, NULL);\
+        for (i = 0; i < iters; i++) {\
+            while (trb_spsc_pop(spsc_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+            sum += v.v;\
+        }\
+        pthread_join(thr, NULL);\
+        report_rate("spsc_stream", "spsc", SZ, BENCH_SPSC_CAP, iters, bench_now_ns() - t0);\
+        \
+        t0 = bench_now_ns();\
+        pthread_create(&thr, NULL, spsc_batch_##SZ, NULL);\
+        for (i = 0; i < iters; i++) {\
+            while (trb_spsc_pop(spsc_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+            sum += v.v;\
+        }\
+        pthread_join(thr, NULL);\
+        report_rate("spsc_stream_batch", "spsc", SZ, BENCH_SPSC_CAP, iters, bench_now_ns() - t0);\
+        \
+        pthread_create(&thr, NULL, spsc_echo_##SZ, NULL);\
+        for (i = 0; i < BENCH_SAMPLES; i++) {\
+            t0 = bench_now_ns();\
+            trb_spsc_push(spsc_##SZ, &v);\
+            while (trb_spsc_pop(pong_##SZ, &v) != 0) {\
+                bench_relax();\
+            }\
+            bench_lat[i] = (uint32_t)((bench_now_ns() - t0) / 2);\
+        }\
+        pthread_join(thr, NULL);\
+        report_latency("spsc_handoff", "spsc", SZ, BENCH_SPSC_CAP, bench_lat, BENCH_SAMPLES);\
+        \
+        bench_sink = sum;\
+    }
+
+BENCH_SPSC(4)
+BENCH_SPSC(64)
+BENCH_SPSC(256)
+
+int main(int argc, char *argv[])
+{
+    size_t iters = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 0) : (size_t)1 << 22;
+    uint64_t t0, timer = UINT64_MAX;
+    int i;
+
+    bench_ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    for (i = 0; i < 1000; i++) {
+        t0 = bench_now_ns();
+        t0 = bench_now_ns() - t0;
+        if (t0 < timer) {
+            timer = t0;
+        }
+    }
+    /* Latency samples include one timer read, reported here for reference */
+    printf("{\"bench\":\"meta\",\"iterations\":%zu,\"cpus\":%ld,\"timer_overhead_ns\":%u}\n",
+           iters, bench_ncpu, (unsigned)timer);
+
+    bench_local_4_64(iters);
+    bench_local_4_4096(iters);
+    bench_local_64_64(iters);
+    bench_local_64_4096(iters);
+    bench_local_256_64(iters);
+    bench_local_256_4096(iters);
+
+    bench_spsc_4(iters);
+    bench_spsc_64(iters);
+    bench_spsc_256(iters);
+
+    return 0;
+}
@@ -14,14 +14,14 @@ TRB_RB_DEFINE(user_type_t, test, 3);
 /* Multiple buffers are fine as long as names are unique */
 TRB_RB_DEFINE(int, test1, 10);
 
-int main(int argc, char *argv[])
+int main(void)
 {
     user_type_t a = {1, 2};
     user_type_t b = {3, 4};
     user_type_t c = {5, 6};
     user_type_t value = {0};
 
-    printf("Capacity: %d\r\n", trb_capacity(test));
+    printf("Capacity: %zu\r\n", trb_capacity(test));
 
     printf("------------FIFO------------\r\n");
     /* Push three items */
@@ -35,8 +35,8 @@ int main(int argc, char *argv[])
     trb_fifo_force_push(test, &b);
     trb_fifo_force_push(test, &b);
     trb_fifo_force_push(test, &b);
-    printf("Element count: %d\r\n", trb_size(test));
-    printf("Remaining capacity: %d\r\n", trb_remaining(test));
+    printf("Element count: %zu\r\n", trb_size(test));
+    printf("Remaining capacity: %zu\r\n", trb_remaining(test));
 
     trb_fifo_pop(test, &value);
     printf("Value: {%d, %d}\r\n", value.a, value.b);
@@ -52,8 +52,8 @@ int main(int argc, char *argv[])
     trb_flush(test);
 
     printf("Buffer empty, pop fails: %d\r\n", trb_fifo_pop(test, &value));
-    printf("Element count: %d\r\n", trb_size(test));
-    printf("Remaining space: %d\r\n", trb_remaining(test));
+    printf("Element count: %zu\r\n", trb_size(test));
+    printf("Remaining space: %zu\r\n", trb_remaining(test));
 
     printf("------------LIFO------------\r\n");
 
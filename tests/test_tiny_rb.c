@@ -0,0 +1,282 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb.c
+ *
+ * \brief Tests for tiny_rb.h: wrap, full/empty, force push, bulk and
+ *        zero-copy span boundaries, deque/LIFO ends, power-of-two buffers
+ *        with free-running counters, the runtime handle, stats and trace
+ *        hooks.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "trb_test.h"
+
+static int trace_ops[5];
+static size_t trace_depth;
+
+static void test_trace(const char *name, int op, size_t depth)
+{
+    (void)name;
+    trace_ops[op]++;
+    trace_depth = depth;
+}
+
+#define TRB_ENABLE_STATS
+#define TRB_TRACE_HOOK(NAME_STR, OP, DEPTH) test_trace(NAME_STR, OP, DEPTH)
+#include "tiny_rb.h"
+
+TRB_RB_DEFINE_STATIC(int, fifo, 5);
+TRB_RB_DEFINE_STATIC(int, bulk, 7);
+TRB_RB_DEFINE_STATIC(int, zc, 6);
+TRB_RB_DEFINE_STATIC(int, dq, 4);
+TRB_RB_DEFINE_POW2_STATIC(int, p2, 8);
+TRB_RB_DEFINE_STATIC(int, st, 2);
+
+static void test_fifo_wrap(void)
+{
+    int v, i, round;
+
+    TRB_CHECK(trb_is_empty(fifo) && !trb_is_full(fifo));
+    TRB_CHECK(trb_fifo_pop(fifo, &v) == -1);
+    TRB_CHECK(trb_fifo_peek(fifo, &v) == -1);
+    /* Many rounds of partial fill move head/tail across the wrap point */
+    for (round = 0, i = 0; round < 20; round++) {
+        int k, first = i;
+
+        for (k = 0; k < 3; k++, i++) {
+            TRB_CHECK(trb_fifo_push(fifo, &i) == 0);
+        }
+        TRB_CHECK(trb_size(fifo) == 3 && trb_remaining(fifo) == 2);
+        TRB_CHECK(trb_fifo_peek(fifo, &v) == 0 && v == first);
+        for (k = 0; k < 3; k++) {
+            TRB_CHECK(trb_fifo_pop(fifo, &v) == 0 && v == first + k);
+        }
+    }
+    for (i = 0; i < 5; i++) {
+        TRB_CHECK(trb_fifo_push(fifo, &i) == 0);
+    }
+    TRB_CHECK(trb_is_full(fifo) && trb_fifo_push(fifo, &i) == -1);
+    trb_flush(fifo);
+    TRB_CHECK(trb_is_empty(fifo) && trb_capacity(fifo) == 5);
+}
+
+static void test_fifo_force_push(void)
+{
+    int v, i;
+
+    for (i = 0; i < 12; i++) {
+        trb_fifo_force_push(fifo, &i);
+    }
+    TRB_CHECK(trb_is_full(fifo));
+    for (i = 7; i < 12; i++) {
+        TRB_CHECK(trb_fifo_pop(fifo, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_is_empty(fifo));
+}
+
+static void test_bulk_boundaries(void)
+{
+    int src[16], dst[16], i, start;
+
+    for (i = 0; i < 16; i++) {
+        src[i] = 100 + i;
+    }
+    /* Every start offset, every length, including split at the wrap */
+    for (start = 0; start < 7; start++) {
+        size_t n;
+
+        trb_flush(bulk);
+        for (i = 0; i < start; i++) {
+            trb_fifo_push(bulk, &i);
+            trb_fifo_pop(bulk, &i);
+        }
+        for (n = 0; n <= 7; n++) {
+            TRB_CHECK(trb_fifo_push_n(bulk, src, n) == n);
+            memset(dst, 0, sizeof(dst));
+            TRB_CHECK(trb_fifo_pop_n(bulk, dst, n) == n);
+            TRB_CHECK(memcmp(dst, src, n * sizeof(int)) == 0);
+            TRB_CHECK(trb_is_empty(bulk));
+        }
+    }
+    /* Partial push when nearly full, partial pop when nearly empty */
+    TRB_CHECK(trb_fifo_push_n(bulk, src, 5) == 5);
+    TRB_CHECK(trb_fifo_push_n(bulk, src + 5, 10) == 2);
+    TRB_CHECK(trb_is_full(bulk));
+    TRB_CHECK(trb_fifo_pop_n(bulk, dst, 16) == 7);
+    TRB_CHECK(memcmp(dst, src, 7 * sizeof(int)) == 0);
+    TRB_CHECK(trb_fifo_pop_n(bulk, dst, 1) == 0);
+}
+
+static void test_zero_copy_boundaries(void)
+{
+    int *p, *p1, *p2, v, i;
+    size_t n, n1, n2;
+
+    /* Move tail to index 4 of 6 */
+    for (i = 0; i < 4; i++) {
+        trb_fifo_push(zc, &i);
+        trb_fifo_pop(zc, &v);
+    }
+    n = trb_fifo_reserve(zc, &p, 10);
+    TRB_CHECK(n == 2);                  /* Stops at the end of the storage */
+    p[0] = 40;
+    p[1] = 41;
+    trb_fifo_commit(zc, 2);
+    n = trb_fifo_reserve(zc, &p, 10);
+    TRB_CHECK(n == 4 && p == &_trb_zc_buf.buf[0]);
+    p[0] = 42;
+    trb_fifo_commit(zc, 1);
+    TRB_CHECK(trb_size(zc) == 3);
+
+    TRB_CHECK(trb_spans(zc, &p1, &n1, &p2, &n2) == 2);
+    TRB_CHECK(n1 == 2 && n2 == 1 && p1[0] == 40 && p2[0] == 42);
+    TRB_CHECK(*trb_at(zc, 2) == 42 && trb_at(zc, 3) == NULL);
+
+    n = trb_fifo_peek_span(zc, &p);
+    TRB_CHECK(n == 2 && p[1] == 41);
+    trb_fifo_release(zc, 2);
+    n = trb_fifo_peek_span(zc, &p);
+    TRB_CHECK(n == 1 && p[0] == 42);
+    trb_fifo_release(zc, 1);
+    TRB_CHECK(trb_fifo_peek_span(zc, &p) == 0);
+    TRB_CHECK(trb_spans(zc, &p1, &n1, &p2, &n2) == 0 && n1 == 0 && n2 == 0);
+
+    /* Full buffer: nothing to reserve */
+    for (i = 0; i < 6; i++) {
+        trb_fifo_push(zc, &i);
+    }
+    TRB_CHECK(trb_fifo_reserve(zc, &p, 1) == 0);
+    trb_flush(zc);
+}
+
+static void test_deque_lifo(void)
+{
+    int v, i;
+
+    /* push_front from an empty buffer wraps head below 0 */
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_push_front(dq, &i) == 0);
+    }
+    TRB_CHECK(trb_push_front(dq, &i) == -1 && trb_push_back(dq, &i) == -1);
+    TRB_CHECK(trb_peek_front(dq, &v) == 0 && v == 3);
+    TRB_CHECK(trb_peek_back(dq, &v) == 0 && v == 0);
+    TRB_CHECK(trb_pop_back(dq, &v) == 0 && v == 0);
+    TRB_CHECK(trb_pop_front(dq, &v) == 0 && v == 3);
+
+    /* LIFO on the back, FIFO consumption from the front */
+    trb_flush(dq);
+    for (i = 0; i < 3; i++) {
+        TRB_CHECK(trb_lifo_push(dq, &i) == 0);
+    }
+    TRB_CHECK(trb_lifo_peek(dq, &v) == 0 && v == 2);
+    TRB_CHECK(trb_lifo_pop(dq, &v) == 0 && v == 2);
+    TRB_CHECK(trb_fifo_pop(dq, &v) == 0 && v == 0);
+    TRB_CHECK(trb_lifo_pop(dq, &v) == 0 && v == 1);
+    TRB_CHECK(trb_lifo_pop(dq, &v) == -1 && trb_peek_back(dq, &v) == -1);
+}
+
+static void test_pow2_counter_wrap(void)
+{
+    int v, i, *q1, *q2;
+    size_t n1, n2;
+
+    /* Start the free-running counters just below SIZE_MAX */
+    _trb_p2_buf.head = _trb_p2_buf.tail = SIZE_MAX - 3;
+    TRB_CHECK(trb_pow2_is_empty(p2));
+    for (i = 0; i < 8; i++) {
+        TRB_CHECK(trb_pow2_fifo_push(p2, &i) == 0);
+    }
+    TRB_CHECK(trb_pow2_is_full(p2) && trb_pow2_size(p2) == 8);
+    TRB_CHECK(trb_pow2_fifo_push(p2, &i) == -1);
+    TRB_CHECK(*trb_pow2_at(p2, 7) == 7 && trb_pow2_at(p2, 8) == NULL);
+    TRB_CHECK(trb_pow2_spans(p2, &q1, &n1, &q2, &n2) == 2 && n1 + n2 == 8);
+    TRB_CHECK(q1[0] == 0 && q2[n2 - 1] == 7);
+    trb_pow2_fifo_force_push(p2, &i);
+    TRB_CHECK(trb_pow2_fifo_peek(p2, &v) == 0 && v == 1);
+    for (i = 1; i <= 8; i++) {
+        TRB_CHECK(trb_pow2_fifo_pop(p2, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_pow2_fifo_pop(p2, &v) == -1 && trb_pow2_remaining(p2) == 8);
+}
+
+static void test_runtime_handle(void)
+{
+    int storage[5], src[8] = {1, 2, 3, 4, 5, 6, 7, 8}, dst[8], v;
+    void *p, *q;
+    size_t n1, n2;
+    trb_rb_t rb;
+
+    TRB_CHECK(trb_init(&rb, NULL, sizeof(int), 5) == -1);
+    TRB_CHECK(trb_init(&rb, storage, sizeof(int), 0) == -1);
+    TRB_CHECK(trb_init(&rb, storage, sizeof(int), 5) == 0);
+    TRB_CHECK(trb_rb_fifo_push_n(&rb, src, 3) == 3);
+    TRB_CHECK(trb_rb_fifo_pop_n(&rb, dst, 2) == 2 && dst[1] == 2);
+    TRB_CHECK(trb_rb_fifo_push_n(&rb, src + 3, 8) == 4);    /* Wraps */
+    TRB_CHECK(trb_rb_is_full(&rb) && trb_rb_remaining(&rb) == 0);
+    TRB_CHECK(trb_rb_spans(&rb, &p, &n1, &q, &n2) == 2 && n1 == 3 && n2 == 2);
+    TRB_CHECK(*(int *)trb_rb_at(&rb, 4) == 7 && trb_rb_at(&rb, 5) == NULL);
+    trb_rb_fifo_force_push(&rb, &src[7]);
+    TRB_CHECK(trb_rb_fifo_peek(&rb, &v) == 0 && v == 4);
+    TRB_CHECK(trb_rb_lifo_pop(&rb, &v) == 0 && v == 8);
+    TRB_CHECK(trb_rb_push_front(&rb, &src[0]) == 0 && trb_rb_pop_front(&rb, &v) == 0 && v == 1);
+
+    TRB_CHECK(trb_rb_fifo_peek_span(&rb, &p) == 2);         /* Slots 3-4, then wraps */
+    trb_rb_fifo_release(&rb, 2);
+    TRB_CHECK(trb_rb_fifo_peek_span(&rb, &p) == 2 && *(int *)p == 6);
+    trb_rb_fifo_release(&rb, 2);
+    TRB_CHECK(trb_rb_is_empty(&rb));
+    TRB_CHECK(trb_rb_fifo_reserve(&rb, &p, 10) == 3);
+    trb_rb_fifo_commit(&rb, 3);
+    TRB_CHECK(trb_rb_fifo_reserve(&rb, &p, 10) == 2);
+    trb_rb_flush(&rb);
+    TRB_CHECK(trb_rb_size(&rb) == 0 && trb_rb_capacity(&rb) == 5);
+}
+
+static void test_stats_and_trace(void)
+{
+    int v = 1, buf[4];
+    trb_stats_t s;
+
+    memset(trace_ops, 0, sizeof(trace_ops));
+    trb_stats_reset(st);
+    trb_fifo_push(st, &v);
+    trb_push_front(st, &v);
+    trb_fifo_push(st, &v);                      /* Rejected */
+    trb_fifo_force_push(st, &v);                /* Overwrites */
+    trb_pop_back(st, &v);
+    trb_fifo_pop(st, &v);
+    trb_fifo_pop(st, &v);                       /* Underflow */
+    TRB_CHECK(trb_fifo_pop_n(st, buf, 2) == 0);
+    trb_stats(st, &s);
+    TRB_CHECK(s.pushes == 3 && s.pops == 2 && s.rejected == 1);
+    TRB_CHECK(s.overwritten == 1 && s.underflows == 3 && s.peak == 2);
+    TRB_CHECK(trace_ops[TRB_TRACE_PUSH] == 2 && trace_ops[TRB_TRACE_PUSH_FULL] == 1);
+    TRB_CHECK(trace_ops[TRB_TRACE_FORCE_PUSH] == 1 && trace_ops[TRB_TRACE_POP] == 2);
+    TRB_CHECK(trace_ops[TRB_TRACE_POP_EMPTY] == 1 && trace_depth == 0);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb\n");
+    TRB_RUN(test_fifo_wrap);
+    TRB_RUN(test_fifo_force_push);
+    TRB_RUN(test_bulk_boundaries);
+    TRB_RUN(test_zero_copy_boundaries);
+    TRB_RUN(test_deque_lifo);
+    TRB_RUN(test_pow2_counter_wrap);
+    TRB_RUN(test_runtime_handle);
+    TRB_RUN(test_stats_and_trace);
+    return 0;
+}
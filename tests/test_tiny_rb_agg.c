@@ -0,0 +1,122 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_agg.c
+ *
+ * \brief Tests for tiny_rb_agg.h: running sum, mean and variance against a
+ *        brute-force scan across the wrap, the empty-buffer reset, drift
+ *        correction by the periodic resync, and unsigned element types.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <math.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+
+#define TRB_AGG_RESYNC_INTERVAL 16
+#include "tiny_rb_agg.h"
+
+TRB_AGG_DEFINE_STATIC(int32_t, ai, 6);
+TRB_AGG_DEFINE_STATIC(double, ad, 4);
+TRB_AGG_DEFINE_STATIC(unsigned char, au, 4);
+
+static void test_model(void)
+{
+    uint32_t rng = 7;
+    int32_t v;
+    int step;
+
+    TRB_CHECK(trb_agg_sum(ai) == 0.0 && trb_agg_mean(ai) == 0.0 && trb_agg_variance(ai) == 0.0);
+    TRB_CHECK(trb_agg_pop(ai, &v) == -1);
+    for (step = 0; step < 100000; step++) {
+        double s = 0.0, q = 0.0, mean;
+        size_t i, n;
+        int ret;
+
+        rng = rng * 1103515245u + 12345u;
+        v = (int32_t)((rng >> 16) % 2001) - 1000;
+        switch (rng & 3) {
+        case 0:
+            ret = trb_is_empty(ai) ? -1 : 0;
+            TRB_CHECK(trb_agg_pop(ai, &v) == ret);
+            break;
+        case 1:
+            ret = trb_is_full(ai) ? -1 : 0;
+            TRB_CHECK(trb_agg_push(ai, &v) == ret);
+            break;
+        default:
+            trb_agg_force_push(ai, &v);
+            break;
+        }
+        n = trb_size(ai);
+        for (i = 0; i < n; i++) {
+            double e = (double)*trb_at(ai, i);
+
+            s += e;
+            q += e * e;
+        }
+        /* Small integers: every partial sum is exact in double */
+        TRB_CHECK(trb_agg_sum(ai) == s);
+        mean = n ? s / (double)n : 0.0;
+        TRB_CHECK(trb_agg_mean(ai) == mean);
+        TRB_CHECK(fabs(trb_agg_variance(ai) - (n ? q / (double)n - mean * mean : 0.0)) < 1e-6);
+    }
+}
+
+static void test_resync_drift(void)
+{
+    double big = 1e17, small = 1.0, v;
+    int i;
+
+    /* The big value swallows the small ones; removing it leaves garbage */
+    trb_agg_push(ad, &big);
+    for (i = 0; i < 3; i++) {
+        trb_agg_push(ad, &small);
+    }
+    TRB_CHECK(trb_agg_pop(ad, &v) == 0 && v == big);
+    trb_agg_resync(ad);
+    TRB_CHECK(trb_agg_sum(ad) == 3.0);
+    /* The periodic resync gets there on its own within the interval */
+    trb_agg_push(ad, &big);
+    TRB_CHECK(trb_agg_pop(ad, &v) == 0 && v == 1.0);
+    for (i = 0; i < 16; i++) {
+        trb_agg_force_push(ad, &small);
+    }
+    TRB_CHECK(trb_agg_sum(ad) == 4.0 && trb_agg_mean(ad) == 1.0 && trb_agg_variance(ad) == 0.0);
+    /* Draining to empty resets the aggregates */
+    while (trb_agg_pop(ad, &v) == 0) {
+    }
+    TRB_CHECK(trb_agg_sum(ad) == 0.0);
+    trb_agg_flush(ad);
+    TRB_CHECK(trb_is_empty(ad) && trb_agg_mean(ad) == 0.0);
+}
+
+static void test_unsigned_char(void)
+{
+    unsigned char u = 200;
+
+    trb_agg_push(au, &u);
+    u = 250;
+    trb_agg_push(au, &u);
+    TRB_CHECK(trb_agg_sum(au) == 450.0 && trb_agg_mean(au) == 225.0);
+    trb_agg_resync(au);
+    TRB_CHECK(trb_agg_sum(au) == 450.0 && trb_agg_variance(au) == 625.0);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_agg\n");
+    TRB_RUN(test_model);
+    TRB_RUN(test_resync_drift);
+    TRB_RUN(test_unsigned_char);
+    return 0;
+}
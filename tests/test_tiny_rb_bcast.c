@@ -0,0 +1,161 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_bcast.c
+ *
+ * \brief Tests for tiny_rb_bcast.h: the slowest reader gating push, drops
+ *        on force push, reader sync, and threaded runs where every reader
+ *        must see the full sequence (push) or an increasing sequence whose
+ *        gaps match its drop count (force push).
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_bcast.h"
+
+#define READERS      3
+#define STRESS_ITEMS 100000u
+
+TRB_BCAST_DEFINE_STATIC(uint32_t, bc, 4, 2);
+TRB_BCAST_DEFINE_STATIC(uint32_t, lossless, 64, READERS);
+TRB_BCAST_DEFINE_STATIC(uint32_t, lossy, 16, READERS);
+
+static atomic_int writer_done;
+
+static void test_gate_and_drops(void)
+{
+    uint32_t v, i;
+
+    TRB_CHECK(trb_bcast_capacity(bc) == 4 && trb_bcast_pop(bc, 0, &v) == -1);
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_bcast_push(bc, &i) == 0);
+    }
+    /* Reader 0 catches up, reader 1 still holds every slot */
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_bcast_pop(bc, 0, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_bcast_pop(bc, 0, &v) == -1);
+    TRB_CHECK(trb_bcast_push(bc, &i) == -1);
+    TRB_CHECK(trb_bcast_pending(bc, 0) == 0 && trb_bcast_pending(bc, 1) == 4);
+    TRB_CHECK(trb_bcast_pop(bc, 1, &v) == 0 && v == 0);
+    TRB_CHECK(trb_bcast_push(bc, &i) == 0);
+    /* Force pushes run reader 1 over: it loses its oldest elements */
+    for (i = 5; i < 8; i++) {
+        trb_bcast_force_push(bc, &i);
+    }
+    TRB_CHECK(trb_bcast_pending(bc, 1) == 7);
+    TRB_CHECK(trb_bcast_pop(bc, 1, &v) == 0 && v == 4);
+    TRB_CHECK(trb_bcast_dropped(bc, 1) == 3 && trb_bcast_dropped(bc, 0) == 0);
+    for (i = 4; i < 8; i++) {
+        TRB_CHECK(trb_bcast_pop(bc, 0, &v) == 0 && v == i);
+    }
+    trb_bcast_reader_sync(bc, 1);
+    TRB_CHECK(trb_bcast_pending(bc, 1) == 0 && trb_bcast_pop(bc, 1, &v) == -1);
+}
+
+static void *lossless_reader(void *arg)
+{
+    size_t r = (size_t)(uintptr_t)arg;
+    uint32_t v, expect = 0;
+
+    while (expect < STRESS_ITEMS) {
+        if (trb_bcast_pop(lossless, r, &v) == 0) {
+            TRB_CHECK(v == expect);
+            expect++;
+        } else {
+            sched_yield();
+        }
+    }
+    TRB_CHECK(trb_bcast_dropped(lossless, r) == 0);
+    return NULL;
+}
+
+static void *lossy_reader(void *arg)
+{
+    size_t r = (size_t)(uintptr_t)arg;
+    uint32_t v, seen = 0, last = 0;
+
+    for (;;) {
+        if (trb_bcast_pop(lossy, r, &v) == 0) {
+            TRB_CHECK(seen == 0 || v > last);
+            last = v;
+            seen++;
+        } else if (atomic_load(&writer_done)) {
+            if (trb_bcast_pending(lossy, r) == 0) {
+                break;
+            }
+        } else {
+            sched_yield();
+        }
+    }
+    /* Every element was either read or counted as dropped */
+    TRB_CHECK(last == STRESS_ITEMS - 1);
+    TRB_CHECK(seen + trb_bcast_dropped(lossy, r) == STRESS_ITEMS);
+    return NULL;
+}
+
+static void run_readers(void *(*fn)(void *), pthread_t *th)
+{
+    uintptr_t r;
+
+    for (r = 0; r < READERS; r++) {
+        TRB_CHECK(pthread_create(&th[r], NULL, fn, (void *)r) == 0);
+    }
+}
+
+static void test_threaded_lossless(void)
+{
+    pthread_t th[READERS];
+    uint32_t i;
+    int r;
+
+    run_readers(lossless_reader, th);
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        while (trb_bcast_push(lossless, &i) != 0) {
+            sched_yield();
+        }
+    }
+    for (r = 0; r < READERS; r++) {
+        pthread_join(th[r], NULL);
+    }
+}
+
+static void test_threaded_force_push(void)
+{
+    pthread_t th[READERS];
+    uint32_t i;
+    int r;
+
+    run_readers(lossy_reader, th);
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        trb_bcast_force_push(lossy, &i);
+        if ((i & 255) == 0) {
+            sched_yield();
+        }
+    }
+    atomic_store(&writer_done, 1);
+    for (r = 0; r < READERS; r++) {
+        pthread_join(th[r], NULL);
+    }
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_bcast\n");
+    TRB_RUN(test_gate_and_drops);
+    TRB_RUN(test_threaded_lossless);
+    TRB_RUN(test_threaded_force_push);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_dma.c
+ *
+ * \brief Tests for tiny_rb_dma.h with mock cache maintenance hooks: the
+ *        exact ranges invalidated on commit and cleaned on transmit, commits
+ *        that would run past the end of the storage, overruns, short
+ *        commits and spans across the wrap.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+
+/* Last range passed to each hook, and how many times it ran */
+typedef struct {
+    const void *addr;
+    size_t      bytes;
+    int         calls;
+} hook_rec_t;
+
+static hook_rec_t inval, clean;
+
+static void record(hook_rec_t *r, const void *addr, size_t bytes)
+{
+    r->addr = addr;
+    r->bytes = bytes;
+    r->calls++;
+}
+
+#define TRB_DMA_ALIGN 64
+#define TRB_DMA_INVALIDATE(ADDR, BYTES) record(&inval, ADDR, BYTES)
+#define TRB_DMA_CLEAN(ADDR, BYTES)      record(&clean, ADDR, BYTES)
+#include "tiny_rb_dma.h"
+
+/* One chunk is one 64-byte line of uint16_t */
+#define CHUNK  32
+#define CHUNKS 4
+
+TRB_DMA_DEFINE_STATIC(uint16_t, rx, CHUNK, CHUNKS);
+
+static void check_inval(int calls, const void *addr, size_t elems)
+{
+    TRB_CHECK(inval.calls == calls && inval.addr == addr && inval.bytes == elems * sizeof(uint16_t));
+}
+
+static void test_commit_ranges(void)
+{
+    const uint16_t *p;
+    uint16_t *t;
+    size_t i;
+
+    TRB_CHECK(trb_dma_capacity(rx) == CHUNK * CHUNKS && trb_dma_size(rx) == 0);
+    /* Full chunks land at chunk 0, 1, 2 */
+    for (i = 0; i < 3; i++) {
+        t = trb_dma_target(rx);
+        TRB_CHECK(t == trb_dma_chunk(rx, i));
+        t[0] = (uint16_t)i;
+        TRB_CHECK(trb_dma_commit(rx, CHUNK) == 0);
+        check_inval((int)i + 1, trb_dma_chunk(rx, i), CHUNK);
+    }
+    /* Make room so only the end of the storage stops the next commit */
+    trb_dma_release(rx, 2 * CHUNK);
+    TRB_CHECK(trb_dma_target(rx) == trb_dma_chunk(rx, 3));
+    TRB_CHECK(trb_dma_commit(rx, 2 * CHUNK) == -1);
+    TRB_CHECK(inval.calls == 3 && trb_dma_overruns(rx) == 0 && trb_dma_size(rx) == CHUNK);
+    TRB_CHECK(trb_dma_commit(rx, CHUNK + 1) == -1 && inval.calls == 3);
+    TRB_CHECK(trb_dma_commit(rx, CHUNK) == 0);
+    check_inval(4, trb_dma_chunk(rx, 3), CHUNK);
+    /* The next target wraps to chunk 0 */
+    TRB_CHECK(trb_dma_target(rx) == trb_dma_chunk(rx, 0));
+
+    /* Readable: chunks 2-3 up to the end, then nothing more */
+    TRB_CHECK(trb_dma_peek_span(rx, &p) == 2 * CHUNK && p == trb_dma_chunk(rx, 2) && *p == 2);
+    trb_dma_release(rx, 2 * CHUNK);
+    TRB_CHECK(trb_dma_size(rx) == 0);
+}
+
+static void test_short_commit_and_overrun(void)
+{
+    const uint16_t *p;
+    uint16_t *t;
+    uint16_t v = 0;
+    size_t i;
+
+    /* Idle-line event: 10 elements, then the rest of the chunk */
+    t = trb_dma_target(rx);
+    TRB_CHECK(t == trb_dma_chunk(rx, 0));
+    TRB_CHECK(trb_dma_commit(rx, 10) == 0);
+    check_inval(5, t, 10);
+    TRB_CHECK(trb_dma_commit(rx, CHUNK - 10) == 0);
+    check_inval(6, t + 10, CHUNK - 10);
+    for (i = 1; i < CHUNKS; i++) {
+        TRB_CHECK(trb_dma_commit(rx, CHUNK) == 0);
+    }
+    TRB_CHECK(trb_dma_size(rx) == CHUNK * CHUNKS && trb_dma_target(rx) == NULL);
+    /* No room: counted as an overrun and nothing is invalidated */
+    TRB_CHECK(trb_dma_commit(rx, 1) == -1);
+    TRB_CHECK(trb_dma_overruns(rx) == 1 && inval.calls == 6 + CHUNKS - 1);
+    TRB_CHECK(trb_dma_push(rx, &v) == -1);
+
+    /* Transmit side cleans up to one chunk from head */
+    TRB_CHECK(trb_dma_pop(rx, &v) == 0);
+    TRB_CHECK(trb_dma_tx_chunk(rx, &p) == CHUNK && p == trb_dma_chunk(rx, 0) + 1);
+    TRB_CHECK(clean.calls == 1 && clean.addr == p && clean.bytes == CHUNK * sizeof(uint16_t));
+    trb_dma_tx_done(rx, CHUNK);
+    /* The last run before the end of the storage is one short */
+    trb_dma_release(rx, CHUNK);
+    TRB_CHECK(trb_dma_tx_chunk(rx, &p) == CHUNK && p == trb_dma_chunk(rx, 2) + 1);
+    trb_dma_tx_done(rx, CHUNK);
+    TRB_CHECK(trb_dma_tx_chunk(rx, &p) == CHUNK - 1 && p == trb_dma_chunk(rx, 3) + 1);
+    TRB_CHECK(clean.calls == 3 && clean.bytes == (CHUNK - 1) * sizeof(uint16_t));
+    trb_dma_tx_done(rx, CHUNK - 1);
+    TRB_CHECK(trb_dma_size(rx) == 0 && trb_dma_tx_chunk(rx, &p) == 0);
+    v = 42;
+    TRB_CHECK(trb_dma_push(rx, &v) == 0 && trb_dma_pop(rx, &v) == 0 && v == 42);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_dma\n");
+    TRB_RUN(test_commit_ranges);
+    TRB_RUN(test_short_commit_and_overrun);
+    return 0;
+}
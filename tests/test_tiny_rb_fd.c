@@ -0,0 +1,71 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_fd.c
+ *
+ * \brief Tests for tiny_rb_fd.h over a pipe: reads and writes that wrap
+ *        into a second iovec, full/empty returns, EOF and EAGAIN.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trb_test.h"
+#include "tiny_rb_fd.h"
+
+TRB_RB_DEFINE_STATIC(unsigned char, io, 10);
+
+static void test_pipe_wrap(void)
+{
+    unsigned char out[16];
+    unsigned char c;
+    int p[2];
+    int i;
+
+    TRB_CHECK(pipe(p) == 0);
+    TRB_CHECK(fcntl(p[0], F_SETFL, O_NONBLOCK) == 0);
+    TRB_CHECK(trb_drain_to_fd(io, p[1]) == -2);                 /* Empty */
+    TRB_CHECK(trb_fill_from_fd(io, p[0]) == -1 && errno == EAGAIN);
+
+    /* Move head and tail to slot 7 */
+    for (i = 0; i < 7; i++) {
+        c = (unsigned char)i;
+        TRB_CHECK(trb_fifo_push(io, &c) == 0 && trb_fifo_pop(io, &c) == 0);
+    }
+    /* 9 bytes land in slots 7-9 and 0-5 with one readv */
+    TRB_CHECK(write(p[1], "abcdefghi", 9) == 9);
+    TRB_CHECK(trb_fill_from_fd(io, p[0]) == 9 && trb_size(io) == 9);
+    TRB_CHECK(*trb_at(io, 0) == 'a' && *trb_at(io, 8) == 'i');
+    TRB_CHECK(write(p[1], "jk", 2) == 2);
+    TRB_CHECK(trb_fill_from_fd(io, p[0]) == 1 && trb_is_full(io));
+    TRB_CHECK(trb_fill_from_fd(io, p[0]) == -2);                /* Full */
+    TRB_CHECK(trb_fifo_pop(io, &c) == 0 && c == 'a');
+
+    /* 9 bytes out of slots 8-9 and 0-6 with one writev */
+    TRB_CHECK(trb_drain_to_fd(io, p[1]) == 9 && trb_is_empty(io));
+    /* The 'k' that did not fit is still in the pipe ahead of them */
+    TRB_CHECK(read(p[0], out, sizeof(out)) == 10);
+    TRB_CHECK(memcmp(out, "kbcdefghij", 10) == 0);
+
+    close(p[1]);
+    TRB_CHECK(trb_fill_from_fd(io, p[0]) == 0);                 /* EOF */
+    close(p[0]);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_fd\n");
+    TRB_RUN(test_pipe_wrap);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_hpp.cpp
+ *
+ * \brief Tests for tiny_rb.hpp: wrap, full/empty, move-only elements,
+ *        constructor/destructor balance of the in-place storage, and moving
+ *        a wrapped ring.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "trb_test.h"
+#include "tiny_rb.hpp"
+
+/* Counts live instances so leaks and double destruction show up */
+struct tracked {
+    static int live;
+    int value;
+
+    explicit tracked(int v) : value(v) { ++live; }
+    tracked(const tracked &o) : value(o.value) { ++live; }
+    tracked(tracked &&o) noexcept : value(o.value) { o.value = -1; ++live; }
+    tracked &operator=(const tracked &o) { value = o.value; return *this; }
+    tracked &operator=(tracked &&o) noexcept { value = o.value; o.value = -1; return *this; }
+    ~tracked() { --live; }
+};
+
+int tracked::live = 0;
+
+static void test_wrap_full_empty()
+{
+    tiny_rb::ring<std::string, 4> r;
+    std::string out;
+    int next = 0, expect = 0;
+
+    static_assert(tiny_rb::ring<std::string, 4>::capacity() == 4, "capacity");
+    TRB_CHECK(r.empty() && r.remaining() == 4 && !r.try_pop(out));
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 4; i++, next++) {
+            TRB_CHECK(r.try_push(std::to_string(next)));
+        }
+        TRB_CHECK(r.full() && !r.emplace("x") && r.size() == 4);
+        for (int i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(r.front() == std::to_string(expect));
+            TRB_CHECK(r.try_pop(out) && out == std::to_string(expect));
+        }
+        TRB_CHECK(r.size() == 1 && r.try_pop(out) && out == std::to_string(expect++));
+        TRB_CHECK(r.empty());
+        /* Offset the next round */
+        TRB_CHECK(r.emplace(3, 'y') && r.try_pop(out) && out == "yyy");
+    }
+}
+
+static void test_move_only()
+{
+    tiny_rb::ring<std::unique_ptr<int>, 2> r;
+    std::unique_ptr<int> p(new int(7));
+
+    TRB_CHECK(r.try_push(std::move(p)) && p == nullptr);
+    TRB_CHECK(r.emplace(new int(8)));
+    p.reset(new int(9));
+    TRB_CHECK(!r.try_push(std::move(p)) && p != nullptr && *p == 9);   /* Left untouched */
+    TRB_CHECK(r.try_pop(p) && *p == 7);
+    TRB_CHECK(*r.front() == 8);
+}
+
+static void test_lifetimes()
+{
+    {
+        tiny_rb::ring<tracked, 8> r;
+        tracked t(0);
+
+        for (int i = 0; i < 20; i++) {
+            TRB_CHECK(r.emplace(i));
+            if (i % 3 != 0) {
+                TRB_CHECK(r.try_pop(t) && t.value >= 0);
+            }
+        }
+        TRB_CHECK(tracked::live == 1 + (int)r.size());
+        r.clear();
+        TRB_CHECK(r.empty() && tracked::live == 1);
+        for (int i = 0; i < 5; i++) {
+            TRB_CHECK(r.try_push(t));
+        }
+        TRB_CHECK(tracked::live == 6);
+    }
+    /* The destructor destroyed the five elements still in the ring */
+    TRB_CHECK(tracked::live == 0);
+}
+
+static void test_move_ring()
+{
+    {
+        tiny_rb::ring<tracked, 4> a;
+        tracked t(0);
+
+        static_assert(std::is_nothrow_move_constructible<tiny_rb::ring<tracked, 4> >::value,
+                      "noexcept move");
+        /* Wrap a so its elements straddle the end of the storage */
+        for (int i = 0; i < 3; i++) {
+            TRB_CHECK(a.emplace(i) && a.try_pop(t));
+        }
+        for (int i = 10; i < 14; i++) {
+            TRB_CHECK(a.emplace(i));
+        }
+        tiny_rb::ring<tracked, 4> b(std::move(a));
+        TRB_CHECK(a.empty() && b.full() && tracked::live == 1 + 4);
+
+        tiny_rb::ring<tracked, 4> c;
+        TRB_CHECK(c.emplace(99) && c.emplace(98));
+        c = std::move(b);
+        TRB_CHECK(b.empty() && c.size() == 4 && tracked::live == 1 + 4);
+        tiny_rb::ring<tracked, 4> &self = c;
+        c = std::move(self);
+        TRB_CHECK(c.size() == 4);
+        for (int i = 10; i < 14; i++) {
+            TRB_CHECK(c.try_pop(t) && t.value == i);
+        }
+        /* Moved-from rings stay usable */
+        TRB_CHECK(a.emplace(1) && b.emplace(2) && tracked::live == 1 + 2);
+    }
+    TRB_CHECK(tracked::live == 0);
+}
+
+int main()
+{
+    printf("test_tiny_rb_hpp\n");
+    TRB_RUN(test_wrap_full_empty);
+    TRB_RUN(test_move_only);
+    TRB_RUN(test_lifetimes);
+    TRB_RUN(test_move_ring);
+    return 0;
+}
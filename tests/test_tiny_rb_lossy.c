@@ -0,0 +1,122 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_lossy.c
+ *
+ * \brief Tests for tiny_rb_lossy.h: lossless use below capacity, drop
+ *        accounting when the producer laps the consumer, and a threaded
+ *        run where the consumer must see an increasing, untorn sequence.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_lossy.h"
+
+#define STRESS_ITEMS 200000u
+
+/* Two copies of the sequence number, so a torn read shows up */
+typedef struct {
+    uint64_t seq;
+    uint64_t check;
+} sample_t;
+
+TRB_LOSSY_DEFINE_STATIC(uint32_t, lq, 4);
+TRB_LOSSY_DEFINE_STATIC(sample_t, stress, 16);
+
+static atomic_int producer_done;
+
+static void test_wrap_and_drops(void)
+{
+    uint32_t v, i, next = 0, expect = 0;
+    int round;
+
+    TRB_CHECK(trb_lossy_capacity(lq) == 4 && trb_lossy_size(lq) == 0);
+    TRB_CHECK(trb_lossy_pop(lq, &v) == -1);
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 3; i++, next++) {
+            trb_lossy_push(lq, &next);
+        }
+        TRB_CHECK(trb_lossy_size(lq) == 3);
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_lossy_pop(lq, &v) == 0 && v == expect);
+        }
+        TRB_CHECK(trb_lossy_pop(lq, &v) == -1);
+    }
+    TRB_CHECK(trb_lossy_dropped(lq) == 0);
+    /* Lap the consumer: only the newest CAPACITY elements survive */
+    for (i = 0; i < 10; i++, next++) {
+        trb_lossy_push(lq, &next);
+    }
+    TRB_CHECK(trb_lossy_size(lq) == 4);
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_lossy_pop(lq, &v) == 0 && v == next - 4 + i);
+    }
+    TRB_CHECK(trb_lossy_pop(lq, &v) == -1 && trb_lossy_dropped(lq) == 6);
+}
+
+static void *producer(void *arg)
+{
+    sample_t s;
+    uint64_t i;
+
+    (void)arg;
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        s.seq = i;
+        s.check = ~i;
+        trb_lossy_push(stress, &s);
+        if ((i & 127) == 0) {
+            sched_yield();
+        }
+    }
+    atomic_store(&producer_done, 1);
+    return NULL;
+}
+
+static void test_threaded_monotonic(void)
+{
+    pthread_t th;
+    sample_t s;
+    uint64_t seen = 0, last = 0;
+
+    TRB_CHECK(pthread_create(&th, NULL, producer, NULL) == 0);
+    for (;;) {
+        if (trb_lossy_pop(stress, &s) == 0) {
+            TRB_CHECK(s.check == ~s.seq);
+            TRB_CHECK(seen == 0 || s.seq > last);
+            last = s.seq;
+            seen++;
+        } else if (atomic_load(&producer_done)) {
+            if (trb_lossy_pop(stress, &s) == -1) {
+                break;
+            }
+            TRB_CHECK(s.check == ~s.seq && s.seq > last);
+            last = s.seq;
+            seen++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(th, NULL);
+    TRB_CHECK(last == STRESS_ITEMS - 1);
+    TRB_CHECK(seen + trb_lossy_dropped(stress) == STRESS_ITEMS);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_lossy\n");
+    TRB_RUN(test_wrap_and_drops);
+    TRB_RUN(test_threaded_monotonic);
+    return 0;
+}
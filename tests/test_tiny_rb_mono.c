@@ -0,0 +1,125 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_mono.c
+ *
+ * \brief Tests for tiny_rb_mono.h: window min/max against a brute-force
+ *        scan while the window slides across the wrap, with pops, rejected
+ *        pushes, duplicates, signed/unsigned and floating-point elements.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_mono.h"
+
+TRB_MONO_DEFINE_STATIC(int32_t, mi, 7);
+TRB_MONO_DEFINE_STATIC(double, md, 5);
+TRB_MONO_DEFINE_STATIC(uint8_t, mu, 3);
+
+static void test_empty_and_full(void)
+{
+    int32_t v = 0;
+
+    TRB_CHECK(trb_mono_min(mi, &v) == -1 && trb_mono_max(mi, &v) == -1);
+    TRB_CHECK(trb_mono_pop(mi, &v) == -1);
+    for (v = 0; v < 7; v++) {
+        TRB_CHECK(trb_mono_push(mi, &v) == 0);
+    }
+    TRB_CHECK(trb_mono_push(mi, &v) == -1 && trb_is_full(mi));
+    TRB_CHECK(trb_mono_min(mi, &v) == 0 && v == 0);
+    TRB_CHECK(trb_mono_max(mi, &v) == 0 && v == 6);
+    trb_mono_flush(mi);
+    TRB_CHECK(trb_is_empty(mi) && trb_mono_min(mi, &v) == -1);
+}
+
+static void test_sliding_window_model(void)
+{
+    int32_t v, lo, hi, got;
+    uint32_t rng = 1;
+    int step;
+
+    for (step = 0; step < 100000; step++) {
+        size_t i, n;
+
+        rng = rng * 1103515245u + 12345u;
+        v = (int32_t)((rng >> 16) % 41) - 20;           /* Plenty of duplicates */
+        if ((rng & 3) == 0) {
+            int32_t out;
+
+            if (trb_is_empty(mi)) {
+                TRB_CHECK(trb_mono_pop(mi, &out) == -1);
+            } else {
+                TRB_CHECK(trb_mono_pop(mi, &out) == 0);
+            }
+        } else if ((rng & 3) == 1) {
+            int full = trb_is_full(mi);
+
+            TRB_CHECK(trb_mono_push(mi, &v) == (full ? -1 : 0));
+        } else {
+            trb_mono_force_push(mi, &v);
+        }
+        n = trb_size(mi);
+        if (n == 0) {
+            TRB_CHECK(trb_mono_min(mi, &got) == -1 && trb_mono_max(mi, &got) == -1);
+            continue;
+        }
+        lo = hi = *trb_at(mi, 0);
+        for (i = 1; i < n; i++) {
+            int32_t e = *trb_at(mi, i);
+
+            lo = (e < lo) ? e : lo;
+            hi = (e > hi) ? e : hi;
+        }
+        TRB_CHECK(trb_mono_min(mi, &got) == 0 && got == lo);
+        TRB_CHECK(trb_mono_max(mi, &got) == 0 && got == hi);
+    }
+}
+
+static void test_float_and_unsigned(void)
+{
+    double d;
+    uint8_t u;
+
+    d = -0.5;
+    trb_mono_force_push(md, &d);
+    d = 3.25;
+    trb_mono_force_push(md, &d);
+    d = 1e-9;
+    trb_mono_force_push(md, &d);
+    TRB_CHECK(trb_mono_min(md, &d) == 0 && d == -0.5);
+    TRB_CHECK(trb_mono_pop(md, &d) == 0 && trb_mono_min(md, &d) == 0 && d == 1e-9);
+    TRB_CHECK(trb_mono_max(md, &d) == 0 && d == 3.25);
+
+    /* 200 must compare above 100, not as a negative value */
+    u = 100;
+    trb_mono_force_push(mu, &u);
+    u = 200;
+    trb_mono_force_push(mu, &u);
+    TRB_CHECK(trb_mono_max(mu, &u) == 0 && u == 200);
+    TRB_CHECK(trb_mono_min(mu, &u) == 0 && u == 100);
+    u = 0;
+    trb_mono_force_push(mu, &u);
+    u = 255;
+    trb_mono_force_push(mu, &u);                        /* Drops 100 */
+    TRB_CHECK(trb_mono_min(mu, &u) == 0 && u == 0);
+    TRB_CHECK(trb_mono_max(mu, &u) == 0 && u == 255);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_mono\n");
+    TRB_RUN(test_empty_and_full);
+    TRB_RUN(test_sliding_window_model);
+    TRB_RUN(test_float_and_unsigned);
+    return 0;
+}
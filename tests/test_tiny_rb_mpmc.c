@@ -0,0 +1,126 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_mpmc.c
+ *
+ * \brief Tests for tiny_rb_mpmc.h: full/empty across the sequence wrap and
+ *        a threaded checksum with several producers and consumers.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_mpmc.h"
+
+#define PRODUCERS      3
+#define CONSUMERS      3
+#define ITEMS_PER_PROD 100000u
+
+TRB_MPMC_DEFINE_STATIC(uint32_t, q, 4);
+TRB_MPMC_DEFINE_STATIC(uint64_t, stress, 64);
+
+static atomic_uint_fast64_t consumed_sum;
+static atomic_uint_fast64_t consumed_cnt;
+
+static void test_full_empty_wrap(void)
+{
+    uint32_t v, i, next = 0, expect = 0;
+    int round;
+
+    TRB_CHECK(trb_mpmc_is_empty(q) && trb_mpmc_capacity(q) == 4);
+    TRB_CHECK(trb_mpmc_pop(q, &v) == -1);
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 4; i++, next++) {
+            TRB_CHECK(trb_mpmc_push(q, &next) == 0);
+        }
+        TRB_CHECK(trb_mpmc_push(q, &next) == -1 && trb_mpmc_size(q) == 4);
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_mpmc_pop(q, &v) == 0 && v == expect);
+        }
+        TRB_CHECK(trb_mpmc_size(q) == 1);
+        TRB_CHECK(trb_mpmc_pop(q, &v) == 0 && v == expect++);
+        TRB_CHECK(trb_mpmc_pop(q, &v) == -1 && trb_mpmc_is_empty(q));
+    }
+}
+
+static void *producer(void *arg)
+{
+    uint64_t base = (uint64_t)(uintptr_t)arg * ITEMS_PER_PROD;
+    uint32_t i;
+
+    for (i = 0; i < ITEMS_PER_PROD; i++) {
+        uint64_t v = base + i + 1;
+
+        while (trb_mpmc_push(stress, &v) != 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    const uint64_t total = (uint64_t)PRODUCERS * ITEMS_PER_PROD;
+    uint64_t v, sum = 0, cnt = 0;
+
+    (void)arg;
+    while (atomic_load(&consumed_cnt) + cnt < total) {
+        if (trb_mpmc_pop(stress, &v) == 0) {
+            sum += v;
+            cnt++;
+        } else {
+            if (cnt) {
+                atomic_fetch_add(&consumed_sum, sum);
+                atomic_fetch_add(&consumed_cnt, cnt);
+                sum = cnt = 0;
+            }
+            sched_yield();
+        }
+    }
+    atomic_fetch_add(&consumed_sum, sum);
+    atomic_fetch_add(&consumed_cnt, cnt);
+    return NULL;
+}
+
+static void test_threaded_checksum(void)
+{
+    const uint64_t total = (uint64_t)PRODUCERS * ITEMS_PER_PROD;
+    pthread_t prod[PRODUCERS], cons[CONSUMERS];
+    uintptr_t i;
+
+    for (i = 0; i < CONSUMERS; i++) {
+        TRB_CHECK(pthread_create(&cons[i], NULL, consumer, NULL) == 0);
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        TRB_CHECK(pthread_create(&prod[i], NULL, producer, (void *)i) == 0);
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        pthread_join(prod[i], NULL);
+    }
+    for (i = 0; i < CONSUMERS; i++) {
+        pthread_join(cons[i], NULL);
+    }
+    /* Every value 1 .. total exactly once */
+    TRB_CHECK(atomic_load(&consumed_cnt) == total);
+    TRB_CHECK(atomic_load(&consumed_sum) == total * (total + 1) / 2);
+    TRB_CHECK(trb_mpmc_is_empty(stress));
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_mpmc\n");
+    TRB_RUN(test_full_empty_wrap);
+    TRB_RUN(test_threaded_checksum);
+    return 0;
+}
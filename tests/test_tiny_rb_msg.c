@@ -0,0 +1,135 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_msg.c
+ *
+ * \brief Tests for tiny_rb_msg.h: frame sizes, the skip marker written when
+ *        a frame does not fit before the end of the storage, full/empty,
+ *        short destination buffers, and a long randomized run checked
+ *        against a plain model of the queue.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "trb_test.h"
+#include "tiny_rb_msg.h"
+
+TRB_MSG_DEFINE_STATIC(mq, 32);
+TRB_MSG_DEFINE_STATIC(fuzz, 256);
+
+static void fill_msg(unsigned char *p, size_t len, unsigned seed)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        p[i] = (unsigned char)(seed * 31u + i);
+    }
+}
+
+static void test_skip_marker_wrap(void)
+{
+    unsigned char msg[32], out[32];
+    unsigned char *p;
+
+    TRB_CHECK(trb_msg_is_empty(mq) && trb_msg_pop(mq, out, sizeof(out)) == -1);
+    fill_msg(msg, 10, 1);
+    TRB_CHECK(trb_msg_push(mq, msg, 10) == 0);               /* [0, 12) */
+    fill_msg(msg, 10, 2);
+    TRB_CHECK(trb_msg_push(mq, msg, 10) == 0);              /* [12, 24) */
+    TRB_CHECK(trb_msg_used(mq) == 24 && trb_msg_count(mq) == 2);
+    /* The third frame does not fit in [24, 32) and head is still 0 */
+    TRB_CHECK(trb_msg_push(mq, msg, 10) == -1);
+    TRB_CHECK(trb_msg_pop(mq, out, sizeof(out)) == 10);
+    fill_msg(msg, 10, 1);
+    TRB_CHECK(memcmp(out, msg, 10) == 0);
+    /* Now it goes to [0, 12) behind a skip marker over [24, 32) */
+    fill_msg(msg, 10, 3);
+    TRB_CHECK(trb_msg_push(mq, msg, 10) == 0);
+    TRB_CHECK(trb_msg_used(mq) == 32 && trb_msg_count(mq) == 2);
+    TRB_CHECK(trb_msg_push(mq, msg, 0) == -1);               /* Full */
+    TRB_CHECK(trb_msg_pop(mq, out, 4) == -2);                /* Too small, kept */
+    TRB_CHECK(trb_msg_pop(mq, out, sizeof(out)) == 10);
+    fill_msg(msg, 10, 2);
+    TRB_CHECK(memcmp(out, msg, 10) == 0);
+    /* Peek steps over the marker and drops its padding from used */
+    TRB_CHECK(trb_msg_peek(mq, &p) == 10 && trb_msg_used(mq) == 12);
+    fill_msg(msg, 10, 3);
+    TRB_CHECK(memcmp(p, msg, 10) == 0);
+    trb_msg_release(mq);
+    TRB_CHECK(trb_msg_is_empty(mq) && trb_msg_used(mq) == 0);
+    TRB_CHECK(trb_msg_peek(mq, &p) == -1);
+}
+
+static void test_frame_limits(void)
+{
+    unsigned char msg[40], out[40];
+
+    /* An empty ring restarts at offset 0, so a frame of the whole storage fits */
+    TRB_CHECK(trb_msg_push(mq, msg, 0) == 0 && trb_msg_pop(mq, out, sizeof(out)) == 0);
+    TRB_CHECK(trb_msg_push(mq, msg, 9) == 0 && trb_msg_pop(mq, out, sizeof(out)) == 9);
+    TRB_CHECK(trb_msg_push(mq, msg, 31) == -1);               /* Frame of 34 */
+    fill_msg(msg, 30, 4);
+    TRB_CHECK(trb_msg_push(mq, msg, 30) == 0 && trb_msg_used(mq) == 32);
+    TRB_CHECK(trb_msg_pop(mq, out, sizeof(out)) == 30 && memcmp(out, msg, 30) == 0);
+    TRB_CHECK(trb_msg_push(mq, msg, 5) == 0 && trb_msg_push(mq, msg, 5) == 0);
+    trb_msg_flush(mq);
+    TRB_CHECK(trb_msg_is_empty(mq) && trb_msg_used(mq) == 0);
+}
+
+static void test_randomized_model(void)
+{
+    unsigned model_len[128], model_seed[128];
+    unsigned char msg[64], out[64], want[64];
+    unsigned head = 0, tail = 0, seed = 0;
+    uint32_t rng = 12345;
+    int step;
+
+    for (step = 0; step < 200000; step++) {
+        rng = rng * 1103515245u + 12345u;
+        if ((rng >> 16) & 1) {
+            size_t len = (rng >> 20) % 61;
+
+            fill_msg(msg, len, seed);
+            if (trb_msg_push(fuzz, msg, len) == 0) {
+                TRB_CHECK(tail - head < 128);
+                model_len[tail % 128] = (unsigned)len;
+                model_seed[tail % 128] = seed++;
+                tail++;
+            } else {
+                /* Free space is at most two runs, so refusal means the frame is over half of it */
+                TRB_CHECK(2 * _TRB_MSG_FRAME(len) > 256 - trb_msg_used(fuzz));
+            }
+        } else {
+            long len = trb_msg_pop(fuzz, out, sizeof(out));
+
+            if (head == tail) {
+                TRB_CHECK(len == -1);
+                continue;
+            }
+            TRB_CHECK(len == (long)model_len[head % 128]);
+            fill_msg(want, (size_t)len, model_seed[head % 128]);
+            TRB_CHECK(memcmp(out, want, (size_t)len) == 0);
+            head++;
+        }
+        TRB_CHECK(trb_msg_count(fuzz) == tail - head && trb_msg_used(fuzz) <= 256);
+    }
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_msg\n");
+    TRB_RUN(test_skip_marker_wrap);
+    TRB_RUN(test_frame_limits);
+    TRB_RUN(test_randomized_model);
+    return 0;
+}
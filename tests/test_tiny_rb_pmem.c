@@ -0,0 +1,202 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_pmem.c
+ *
+ * \brief Tests for tiny_rb_pmem.h: format/recover round trip across the
+ *        wrap, fault injection for recovery (torn index record, both
+ *        records torn, torn slot CRC before and after the last commit, bad
+ *        header) and reopening a file-backed ring.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "trb_test.h"
+#include "tiny_rb_pmem.h"
+
+#define CAP 8
+
+static _Alignas(TRB_CACHELINE_SIZE) unsigned char region[4096];
+
+static size_t region_size(void)
+{
+    return trb_pmem_region_size(sizeof(uint32_t), CAP);
+}
+
+/* Format the region and push FIRST .. FIRST + N - 1 */
+static void fill(trb_pmem_t *pm, uint32_t first, uint32_t n)
+{
+    uint32_t i;
+
+    TRB_CHECK(trb_pmem_format(pm, region, sizeof(region), sizeof(uint32_t), CAP) == 0);
+    for (i = first; i < first + n; i++) {
+        TRB_CHECK(trb_pmem_push(pm, &i) == 0);
+    }
+}
+
+/* Flip one bit of the element stored for position pos */
+static void tear_slot(const trb_pmem_t *pm, uint64_t pos)
+{
+    ((unsigned char *)(_trb_pmem_slot(pm, pos) + 1))[0] ^= 0x01;
+}
+
+static void test_format_checks(void)
+{
+    trb_pmem_t pm;
+
+    TRB_CHECK(region_size() <= sizeof(region));
+    TRB_CHECK(trb_pmem_format(&pm, region, sizeof(region), 0, CAP) == -1);
+    TRB_CHECK(trb_pmem_format(&pm, region, sizeof(region), 4, 6) == -1);
+    TRB_CHECK(trb_pmem_format(&pm, region, region_size() - 1, 4, CAP) == -1);
+    TRB_CHECK(trb_pmem_format(&pm, region, region_size(), 4, CAP) == 0);
+    TRB_CHECK(trb_pmem_size(&pm) == 0 && trb_pmem_capacity(&pm) == CAP);
+    TRB_CHECK(trb_pmem_recover(&pm, region, region_size() - 1) == -1);
+}
+
+static void test_round_trip_wrap(void)
+{
+    trb_pmem_t pm, rec;
+    uint32_t v, i, next = 0, expect = 0;
+    int round;
+
+    fill(&pm, 0, 0);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == -1);
+    for (round = 0; round < 5; round++) {
+        for (i = 0; i < CAP; i++, next++) {
+            TRB_CHECK(trb_pmem_push(&pm, &next) == 0);
+        }
+        TRB_CHECK(trb_pmem_push(&pm, &next) == -1);
+        for (i = 0; i < 5; i++, expect++) {
+            TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == expect);
+        }
+        /* A reset here must bring back exactly the three unread elements */
+        TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0);
+        TRB_CHECK(trb_pmem_size(&rec) == 3);
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_pmem_pop(&rec, &v) == 0 && v == expect);
+        }
+        TRB_CHECK(trb_pmem_pop(&rec, &v) == -1);
+        pm = rec;
+    }
+    /* force_push drops the oldest */
+    for (i = 0; i < CAP + 2; i++, next++) {
+        trb_pmem_force_push(&pm, &next);
+    }
+    TRB_CHECK(trb_pmem_size(&pm) == CAP);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == next - CAP);
+}
+
+static void test_torn_index_record(void)
+{
+    trb_pmem_t pm, rec;
+    uint32_t v;
+
+    fill(&pm, 10, 4);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == 10);
+    /* The record for that pop is torn: fall back to the one before it */
+    pm.hdr->rec[pm.gen & 1].head ^= 0x100;
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0);
+    TRB_CHECK(rec.gen == pm.gen - 1 && trb_pmem_size(&rec) == 4);
+    TRB_CHECK(trb_pmem_pop(&rec, &v) == 0 && v == 10);
+
+    /* Both records torn: rebuild from the valid slots in front of position 0 */
+    fill(&pm, 20, 5);
+    pm.hdr->rec[0].crc ^= 1;
+    pm.hdr->rec[1].crc ^= 1;
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0);
+    TRB_CHECK(trb_pmem_size(&rec) == 5);
+    TRB_CHECK(trb_pmem_pop(&rec, &v) == 0 && v == 20);
+    /* Recovery re-commits, so a second reset sees the rebuilt index */
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0 && trb_pmem_size(&rec) == 4);
+}
+
+static void test_torn_slot_crc(void)
+{
+    trb_pmem_t pm, rec;
+    uint32_t v, i;
+
+    /* Committed slot whose contents went bad: reported, then skipped */
+    fill(&pm, 30, 3);
+    tear_slot(&pm, 1);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == 30);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == -2);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == 32);
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == -1);
+
+    /* Uncommitted slots: the forward scan stops at the first torn one */
+    TRB_CHECK(trb_pmem_format(&pm, region, sizeof(region), sizeof(uint32_t), CAP) == 0);
+    pm.commit_every = 100;
+    for (v = 40; v < 45; v++) {
+        TRB_CHECK(trb_pmem_push(&pm, &v) == 0);
+    }
+    tear_slot(&pm, 3);
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0);
+    TRB_CHECK(trb_pmem_size(&rec) == 3);
+    TRB_CHECK(trb_pmem_pop(&rec, &v) == 0 && v == 40);
+
+    /* A slot left over from an earlier lap does not count as new */
+    fill(&pm, 50, CAP);
+    for (i = 0; i < CAP; i++) {
+        TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == 50 + i);
+    }
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == 0 && trb_pmem_size(&rec) == 0);
+}
+
+static void test_bad_header(void)
+{
+    trb_pmem_t pm, rec;
+
+    fill(&pm, 0, 2);
+    pm.hdr->capacity = 16;
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == -1);
+    fill(&pm, 0, 2);
+    pm.hdr->magic = 0;
+    TRB_CHECK(trb_pmem_recover(&rec, region, sizeof(region)) == -1);
+}
+
+static void test_file_reopen(void)
+{
+    char path[] = "/tmp/trb_pmem_XXXXXX";
+    trb_pmem_t pm;
+    uint32_t v;
+    int fd = mkstemp(path);
+
+    TRB_CHECK(fd >= 0);
+    close(fd);
+    TRB_CHECK(trb_pmem_open(&pm, path, sizeof(uint32_t), CAP) == 0);
+    for (v = 60; v < 63; v++) {
+        TRB_CHECK(trb_pmem_push(&pm, &v) == 0);
+    }
+    TRB_CHECK(trb_pmem_pop(&pm, &v) == 0 && v == 60);
+    trb_pmem_close(&pm);
+    TRB_CHECK(trb_pmem_open(&pm, path, sizeof(uint32_t), CAP) == 1);
+    TRB_CHECK(trb_pmem_size(&pm) == 2 && trb_pmem_pop(&pm, &v) == 0 && v == 61);
+    trb_pmem_close(&pm);
+    /* A different layout reformats */
+    TRB_CHECK(trb_pmem_open(&pm, path, sizeof(uint64_t), CAP) == 0);
+    TRB_CHECK(trb_pmem_size(&pm) == 0);
+    trb_pmem_close(&pm);
+    unlink(path);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_pmem\n");
+    TRB_RUN(test_format_checks);
+    TRB_RUN(test_round_trip_wrap);
+    TRB_RUN(test_torn_index_record);
+    TRB_RUN(test_torn_slot_crc);
+    TRB_RUN(test_bad_header);
+    TRB_RUN(test_file_reopen);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_pool.c
+ *
+ * \brief Tests for tiny_rb_pool.h: FIFO order across chained segments,
+ *        segment release on drain and flush, free-list reuse between
+ *        queues, and pool exhaustion.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_pool.h"
+
+TRB_POOL_DEFINE_STATIC(uint32_t, pool, 4, 4);
+
+static void test_segment_chaining(void)
+{
+    trb_pool_q_t q = { 0 };
+    uint32_t v, i;
+
+    TRB_CHECK(trb_pool_segment_capacity(pool) == 4 && trb_pool_free_segments(pool) == 4);
+    TRB_CHECK(trb_pool_is_empty(&q) && trb_pool_pop(pool, &q, &v) == -1);
+    TRB_CHECK(trb_pool_peek(pool, &q, &v) == -1);
+    for (i = 0; i < 10; i++) {
+        TRB_CHECK(trb_pool_push(pool, &q, &i) == 0);
+    }
+    TRB_CHECK(trb_pool_size(&q) == 10 && trb_pool_free_segments(pool) == 1);
+    /* Each drained segment goes back to the pool as soon as it empties */
+    for (i = 0; i < 10; i++) {
+        TRB_CHECK(trb_pool_peek(pool, &q, &v) == 0 && v == i);
+        TRB_CHECK(trb_pool_pop(pool, &q, &v) == 0 && v == i);
+        TRB_CHECK(trb_pool_free_segments(pool) == 1 + (i + 1) / 4 + (i == 9));
+    }
+    TRB_CHECK(trb_pool_is_empty(&q) && trb_pool_free_segments(pool) == 4);
+    /* A queue that keeps draining to empty holds one segment at most */
+    for (i = 0; i < 20; i++) {
+        TRB_CHECK(trb_pool_push(pool, &q, &i) == 0 && trb_pool_free_segments(pool) == 3);
+        TRB_CHECK(trb_pool_pop(pool, &q, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_pool_free_segments(pool) == 4);
+}
+
+static void test_shared_pool_release(void)
+{
+    trb_pool_q_t a = { 0 }, b = { 0 };
+    uint32_t v, i, next_b = 100, expect_b = 100;
+
+    for (i = 0; i < 12; i++) {
+        TRB_CHECK(trb_pool_push(pool, &a, &i) == 0);
+    }
+    for (i = 0; i < 4; i++, next_b++) {
+        TRB_CHECK(trb_pool_push(pool, &b, &next_b) == 0);
+    }
+    /* Pool exhausted: b cannot chain a second segment */
+    TRB_CHECK(trb_pool_free_segments(pool) == 0);
+    TRB_CHECK(trb_pool_push(pool, &b, &next_b) == -1 && trb_pool_size(&b) == 4);
+    /* a frees its first segment, b picks it up from the free list */
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_pool_pop(pool, &a, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_pool_free_segments(pool) == 1);
+    for (i = 0; i < 4; i++, next_b++) {
+        TRB_CHECK(trb_pool_push(pool, &b, &next_b) == 0);
+    }
+    TRB_CHECK(trb_pool_push(pool, &a, &v) == -1);
+    trb_pool_flush(pool, &a);
+    TRB_CHECK(trb_pool_is_empty(&a) && trb_pool_free_segments(pool) == 2);
+    for (i = 0; i < 8; i++, next_b++) {
+        TRB_CHECK(trb_pool_push(pool, &b, &next_b) == 0);
+    }
+    TRB_CHECK(trb_pool_size(&b) == 16 && trb_pool_push(pool, &b, &next_b) == -1);
+    while (trb_pool_pop(pool, &b, &v) == 0) {
+        TRB_CHECK(v == expect_b);
+        expect_b++;
+    }
+    TRB_CHECK(expect_b == 116 && trb_pool_free_segments(pool) == 4);
+    /* Flushing a partly drained multi-segment queue releases every segment */
+    for (i = 0; i < 9; i++) {
+        TRB_CHECK(trb_pool_push(pool, &a, &i) == 0);
+    }
+    TRB_CHECK(trb_pool_pop(pool, &a, &v) == 0 && v == 0);
+    trb_pool_flush(pool, &a);
+    TRB_CHECK(trb_pool_free_segments(pool) == 4);
+    trb_pool_flush(pool, &a);
+    TRB_CHECK(trb_pool_free_segments(pool) == 4);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_pool\n");
+    TRB_RUN(test_segment_chaining);
+    TRB_RUN(test_shared_pool_release);
+    return 0;
+}
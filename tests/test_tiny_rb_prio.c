@@ -0,0 +1,101 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_prio.c
+ *
+ * \brief Tests for tiny_rb_prio.h: strict lane priority, FIFO order and
+ *        wrap inside a lane, per-lane full/empty and lane range checks.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_prio.h"
+
+TRB_PRIO_DEFINE_STATIC(uint32_t, pq, 3, 4);
+TRB_PRIO_DEFINE_STATIC(uint32_t, wide, TRB_PRIO_MAX_LANES, 2);
+
+static void test_lane_order(void)
+{
+    uint32_t v, i;
+
+    TRB_CHECK(trb_prio_is_empty(pq) && trb_prio_capacity(pq) == 4);
+    TRB_CHECK(trb_prio_top(pq) == -1 && trb_prio_pop(pq, &v) == -1 && trb_prio_peek(pq, &v) == -1);
+    for (i = 0; i < 4; i++) {
+        uint32_t lo = 100 + i;
+        uint32_t hi = 200 + i;
+
+        TRB_CHECK(trb_prio_push(pq, 0, &lo) == 0);
+        TRB_CHECK(trb_prio_push(pq, 2, &hi) == 0);
+    }
+    TRB_CHECK(trb_prio_push(pq, 0, &v) == -1 && trb_prio_push(pq, 2, &v) == -1);
+    TRB_CHECK(trb_prio_push(pq, 3, &v) == -1);               /* No such lane */
+    TRB_CHECK(trb_prio_size(pq, 0) == 4 && trb_prio_size(pq, 1) == 0);
+    TRB_CHECK(trb_prio_top(pq) == 2);
+    TRB_CHECK(trb_prio_peek(pq, &v) == 2 && v == 200);
+    TRB_CHECK(trb_prio_pop(pq, &v) == 2 && v == 200);
+    /* A middle lane outranks lane 0 but not lane 2 */
+    v = 150;
+    TRB_CHECK(trb_prio_push(pq, 1, &v) == 0);
+    for (i = 1; i < 4; i++) {
+        TRB_CHECK(trb_prio_pop(pq, &v) == 2 && v == 200 + i);
+    }
+    TRB_CHECK(trb_prio_pop(pq, &v) == 1 && v == 150);
+    TRB_CHECK(trb_prio_top(pq) == 0);
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_prio_pop(pq, &v) == 0 && v == 100 + i);
+    }
+    TRB_CHECK(trb_prio_is_empty(pq) && trb_prio_top(pq) == -1);
+}
+
+static void test_lane_wrap_and_flush(void)
+{
+    uint32_t v, i, next = 0, expect = 0;
+    int round;
+
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 3; i++, next++) {
+            TRB_CHECK(trb_prio_push(pq, 1, &next) == 0);
+        }
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_prio_pop(pq, &v) == 1 && v == expect);
+        }
+    }
+    TRB_CHECK(trb_prio_push(pq, 0, &v) == 0 && trb_prio_push(pq, 2, &v) == 0);
+    trb_prio_flush(pq);
+    TRB_CHECK(trb_prio_is_empty(pq) && trb_prio_size(pq, 0) == 0 && trb_prio_size(pq, 2) == 0);
+    TRB_CHECK(trb_prio_pop(pq, &v) == -1);
+}
+
+static void test_all_lanes(void)
+{
+    uint32_t v;
+    int lane;
+
+    for (lane = 0; lane < TRB_PRIO_MAX_LANES; lane++) {
+        v = (uint32_t)lane;
+        TRB_CHECK(trb_prio_push(wide, lane, &v) == 0);
+    }
+    for (lane = TRB_PRIO_MAX_LANES - 1; lane >= 0; lane--) {
+        TRB_CHECK(trb_prio_pop(wide, &v) == lane && v == (uint32_t)lane);
+    }
+    TRB_CHECK(trb_prio_is_empty(wide));
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_prio\n");
+    TRB_RUN(test_lane_order);
+    TRB_RUN(test_lane_wrap_and_flush);
+    TRB_RUN(test_all_lanes);
+    return 0;
+}
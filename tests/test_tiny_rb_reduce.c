@@ -0,0 +1,164 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_reduce.c
+ *
+ * \brief Tests for tiny_rb_reduce.h: every span kernel against a scalar
+ *        loop for all lengths and start offsets around the vector widths,
+ *        extreme values, and the ring wrappers across the wrap for plain and
+ *        power-of-two buffers. Built once with the SIMD path the compiler
+ *        targets and once with TRB_NO_SIMD.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_reduce.h"
+
+#define LEN 80
+
+TRB_RB_DEFINE_STATIC(int16_t, r16, 37);
+TRB_RB_DEFINE_STATIC(float, rf, 37);
+TRB_RB_DEFINE_POW2_STATIC(int32_t, p32, 32);
+
+static int16_t a16[LEN];
+static int32_t a32[LEN];
+static float   af[LEN];
+
+static void fill_arrays(uint32_t seed, int extreme)
+{
+    size_t i;
+
+    for (i = 0; i < LEN; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if (extreme) {
+            a16[i] = (seed & 0x10000) ? INT16_MAX : INT16_MIN;
+            a32[i] = (seed & 0x10000) ? INT32_MAX : INT32_MIN;
+        } else {
+            a16[i] = (int16_t)(seed >> 16);
+            a32[i] = (int32_t)seed;
+        }
+        /* Multiples of 1/4 well inside float range: all sums are exact */
+        af[i] = (float)((int32_t)(seed >> 12) % 4096) * 0.25f;
+    }
+}
+
+static void check_spans(void)
+{
+    size_t off, n, i;
+
+    for (off = 0; off < 9; off++) {
+        for (n = 0; off + n <= LEN; n++) {
+            int64_t s16 = 0, s32 = 0;
+            double sf = 0.0;
+            int16_t mn16 = a16[off], mx16 = a16[off], g16a = a16[off], g16b = a16[off];
+            int32_t mn32 = a32[off], mx32 = a32[off], g32a = a32[off], g32b = a32[off];
+            float mnf = af[off], mxf = af[off], gfa = af[off], gfb = af[off];
+
+            for (i = off; i < off + n; i++) {
+                s16 += a16[i];
+                s32 += a32[i];
+                sf += af[i];
+                mn16 = (a16[i] < mn16) ? a16[i] : mn16;
+                mx16 = (a16[i] > mx16) ? a16[i] : mx16;
+                mn32 = (a32[i] < mn32) ? a32[i] : mn32;
+                mx32 = (a32[i] > mx32) ? a32[i] : mx32;
+                mnf = (af[i] < mnf) ? af[i] : mnf;
+                mxf = (af[i] > mxf) ? af[i] : mxf;
+            }
+            TRB_CHECK(trb_span_sum_i16(a16 + off, n) == s16);
+            TRB_CHECK(trb_span_sum_i32(a32 + off, n) == s32);
+            TRB_CHECK(trb_span_sum_f32(af + off, n) == sf);
+            trb_span_minmax_i16(a16 + off, n, &g16a, &g16b);
+            trb_span_minmax_i32(a32 + off, n, &g32a, &g32b);
+            trb_span_minmax_f32(af + off, n, &gfa, &gfb);
+            TRB_CHECK(g16a == mn16 && g16b == mx16);
+            TRB_CHECK(g32a == mn32 && g32b == mx32);
+            TRB_CHECK(gfa == mnf && gfb == mxf);
+        }
+    }
+}
+
+static void test_span_kernels(void)
+{
+    uint32_t seed;
+
+    for (seed = 1; seed < 6; seed++) {
+        fill_arrays(seed, 0);
+        check_spans();
+    }
+    fill_arrays(99, 1);
+    check_spans();
+}
+
+static void test_ring_wrappers(void)
+{
+    int16_t v16 = 0, mn16, mx16;
+    int32_t v32 = 0, mn32, mx32;
+    float vf, mnf, mxf;
+    int step;
+
+    TRB_CHECK(trb_sum(r16) == 0 && trb_mean(rf) == 0.0 && trb_pow2_sum(p32) == 0);
+    TRB_CHECK(trb_minmax(r16, &mn16, &mx16) == -1 && trb_pow2_minmax(p32, &mn32, &mx32) == -1);
+    for (step = 0; step < 500; step++) {
+        int64_t s16 = 0, s32 = 0;
+        double sf = 0.0;
+        size_t i;
+
+        v16 = (int16_t)(step * 977);
+        vf = (float)(step % 50) - 20.5f;
+        v32 = (int32_t)((uint32_t)step * 2654435761u);
+        trb_fifo_force_push(r16, &v16);
+        trb_fifo_force_push(rf, &vf);
+        trb_pow2_fifo_force_push(p32, &v32);
+        if (step % 7 == 0) {
+            trb_fifo_pop(r16, &v16);
+            trb_fifo_pop(rf, &vf);
+            trb_pow2_fifo_pop(p32, &v32);
+        }
+        if (trb_is_empty(r16)) {
+            TRB_CHECK(trb_sum(r16) == 0 && trb_minmax(rf, &mnf, &mxf) == -1);
+            continue;
+        }
+        mn16 = mx16 = *trb_at(r16, 0);
+        for (i = 0; i < trb_size(r16); i++) {
+            int16_t e = *trb_at(r16, i);
+
+            s16 += e;
+            mn16 = (e < mn16) ? e : mn16;
+            mx16 = (e > mx16) ? e : mx16;
+            sf += *trb_at(rf, i);
+        }
+        for (i = 0; i < trb_pow2_size(p32); i++) {
+            s32 += *trb_pow2_at(p32, i);
+        }
+        TRB_CHECK(trb_sum(r16) == s16 && trb_sum(rf) == sf);
+        TRB_CHECK(trb_mean(r16) == (double)s16 / (double)trb_size(r16));
+        TRB_CHECK(trb_pow2_sum(p32) == s32);
+        TRB_CHECK(trb_pow2_mean(p32) == (double)s32 / (double)trb_pow2_size(p32));
+        {
+            int16_t g1, g2;
+
+            TRB_CHECK(trb_minmax(r16, &g1, &g2) == 0 && g1 == mn16 && g2 == mx16);
+        }
+        TRB_CHECK(trb_minmax(rf, &mnf, &mxf) == 0 && mnf <= mxf);
+        TRB_CHECK(trb_pow2_minmax(p32, &mn32, &mx32) == 0 && mn32 <= mx32);
+    }
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_reduce\n");
+    TRB_RUN(test_span_kernels);
+    TRB_RUN(test_ring_wrappers);
+    return 0;
+}
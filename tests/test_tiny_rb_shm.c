@@ -0,0 +1,199 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_shm.c
+ *
+ * \brief Tests for tiny_rb_shm.h: create/attach argument checks, attach
+ *        rejecting missing, duplicate and mismatched headers, full/empty and
+ *        span boundaries across two handles, the layout cached at attach,
+ *        and a producer in a forked process.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <sched.h>
+#include <stdint.h>
+#include <sys/wait.h>
+
+#include "trb_test.h"
+#include "tiny_rb_shm.h"
+
+#define FORK_ITEMS 100000u
+
+static char shm_name[64];
+
+static void test_create_attach_checks(void)
+{
+    trb_shm_t a, b;
+
+    TRB_CHECK(trb_shm_create(&a, shm_name, 0, 8) == -1);
+    TRB_CHECK(trb_shm_create(&a, shm_name, 4, 0) == -1);
+    TRB_CHECK(trb_shm_create(&a, shm_name, 4, 6) == -1);
+    TRB_CHECK(trb_shm_create(&a, shm_name, SIZE_MAX / 2, 4) == -1);
+    TRB_CHECK(trb_shm_attach(&b, shm_name) == -1);        /* Not created */
+
+    TRB_CHECK(trb_shm_create(&a, shm_name, sizeof(uint32_t), 8) == 0);
+    TRB_CHECK(trb_shm_create(&b, shm_name, sizeof(uint32_t), 8) == -1);
+    TRB_CHECK(trb_shm_attach(&b, shm_name) == 0);
+    TRB_CHECK(trb_shm_capacity(&b) == 8 && trb_shm_size(&b) == 0);
+    trb_shm_detach(&b);
+    trb_shm_detach(&a);
+    TRB_CHECK(trb_shm_unlink(shm_name) == 0);
+    TRB_CHECK(trb_shm_attach(&b, shm_name) == -1);
+}
+
+/* Corrupt one header field through the creator's mapping; attach must refuse */
+static void check_attach_rejects(void (*corrupt)(trb_shm_hdr_t *))
+{
+    trb_shm_t a, b;
+
+    TRB_CHECK(trb_shm_create(&a, shm_name, sizeof(uint32_t), 8) == 0);
+    corrupt(a.hdr);
+    TRB_CHECK(trb_shm_attach(&b, shm_name) == -1);
+    trb_shm_detach(&a);
+    TRB_CHECK(trb_shm_unlink(shm_name) == 0);
+}
+
+static void bad_magic(trb_shm_hdr_t *h)    { atomic_store(&h->magic, 0); }
+static void bad_version(trb_shm_hdr_t *h)  { h->version = TRB_SHM_VERSION + 1; }
+static void bad_hdr_size(trb_shm_hdr_t *h) { h->header_size = 8; }
+static void bad_line(trb_shm_hdr_t *h)     { h->cacheline = TRB_CACHELINE_SIZE * 2; }
+static void bad_esize(trb_shm_hdr_t *h)    { h->elem_size = 0; }
+static void bad_cap(trb_shm_hdr_t *h)      { h->capacity = 6; }
+static void huge_cap(trb_shm_hdr_t *h)     { h->capacity = (uint64_t)1 << 40; }
+static void bad_offset(trb_shm_hdr_t *h)   { h->data_offset = UINT64_MAX; }
+static void overflow(trb_shm_hdr_t *h)     { h->elem_size = UINT64_MAX / 4; h->capacity = 8; }
+
+static void test_attach_mismatch(void)
+{
+    check_attach_rejects(bad_magic);
+    check_attach_rejects(bad_version);
+    check_attach_rejects(bad_hdr_size);
+    check_attach_rejects(bad_line);
+    check_attach_rejects(bad_esize);
+    check_attach_rejects(bad_cap);
+    check_attach_rejects(huge_cap);
+    check_attach_rejects(bad_offset);
+    check_attach_rejects(overflow);
+}
+
+static void test_two_handles(void)
+{
+    trb_shm_t prod, cons;
+    const void *rp;
+    void *wp;
+    uint32_t v, i;
+
+    TRB_CHECK(trb_shm_create(&prod, shm_name, sizeof(uint32_t), 8) == 0);
+    TRB_CHECK(trb_shm_attach(&cons, shm_name) == 0);
+    TRB_CHECK(trb_shm_pop(&cons, &v) == -1);
+    for (i = 0; i < 8; i++) {
+        TRB_CHECK(trb_shm_push(&prod, &i) == 0);
+    }
+    TRB_CHECK(trb_shm_push(&prod, &i) == -1 && trb_shm_size(&cons) == 8);
+    TRB_CHECK(trb_shm_reserve(&prod, &wp, 4) == 0);
+    for (i = 0; i < 6; i++) {
+        TRB_CHECK(trb_shm_pop(&cons, &v) == 0 && v == i);
+    }
+    /* tail sits at slot 0 again, head at slot 6 */
+    TRB_CHECK(trb_shm_reserve(&prod, &wp, 10) == 6);
+    for (i = 0; i < 5; i++) {
+        ((uint32_t *)wp)[i] = 100 + i;
+    }
+    trb_shm_commit(&prod, 5);
+    TRB_CHECK(trb_shm_reserve(&prod, &wp, 10) == 1);
+    /* Readable: slots 6-7, then 0-4 after the wrap */
+    TRB_CHECK(trb_shm_peek_span(&cons, &rp) == 2 && *(const uint32_t *)rp == 6);
+    trb_shm_release(&cons, 2);
+    TRB_CHECK(trb_shm_peek_span(&cons, &rp) == 5 && *(const uint32_t *)rp == 100);
+    trb_shm_release(&cons, 5);
+    TRB_CHECK(trb_shm_peek_span(&cons, &rp) == 0 && trb_shm_size(&cons) == 0);
+    trb_shm_detach(&cons);
+    trb_shm_detach(&prod);
+    TRB_CHECK(trb_shm_unlink(shm_name) == 0);
+}
+
+/* Header writes after attach must not change the bound layout */
+static void test_cached_layout(void)
+{
+    trb_shm_t prod, cons;
+    const void *rp;
+    void *wp;
+    uint32_t v, i;
+
+    TRB_CHECK(trb_shm_create(&prod, shm_name, sizeof(uint32_t), 8) == 0);
+    TRB_CHECK(trb_shm_attach(&cons, shm_name) == 0);
+    prod.hdr->capacity = (uint64_t)1 << 40;
+    prod.hdr->elem_size = 4096;
+    prod.hdr->data_offset = 0;
+    TRB_CHECK(trb_shm_capacity(&cons) == 8 && trb_shm_capacity(&prod) == 8);
+    for (i = 0; i < 8; i++) {
+        TRB_CHECK(trb_shm_push(&prod, &i) == 0);
+    }
+    TRB_CHECK(trb_shm_push(&prod, &i) == -1 && trb_shm_reserve(&prod, &wp, 100) == 0);
+    TRB_CHECK(trb_shm_peek_span(&cons, &rp) == 8 && rp == cons.data);
+    TRB_CHECK(((const uint32_t *)rp)[7] == 7);
+    trb_shm_release(&cons, 8);
+    TRB_CHECK(trb_shm_reserve(&prod, &wp, 100) == 8);
+    TRB_CHECK(trb_shm_pop(&cons, &v) == -1);
+    trb_shm_detach(&cons);
+    trb_shm_detach(&prod);
+    TRB_CHECK(trb_shm_unlink(shm_name) == 0);
+}
+
+static void test_forked_producer(void)
+{
+    trb_shm_t cons;
+    uint32_t v, expect = 0;
+    int status;
+    pid_t pid;
+
+    TRB_CHECK(trb_shm_create(&cons, shm_name, sizeof(uint32_t), 64) == 0);
+    pid = fork();
+    TRB_CHECK(pid >= 0);
+    if (pid == 0) {
+        trb_shm_t prod;
+        uint32_t i;
+
+        if (trb_shm_attach(&prod, shm_name) != 0) {
+            _exit(2);
+        }
+        for (i = 0; i < FORK_ITEMS; i++) {
+            while (trb_shm_push(&prod, &i) != 0) {
+                sched_yield();
+            }
+        }
+        trb_shm_detach(&prod);
+        _exit(0);
+    }
+    while (expect < FORK_ITEMS) {
+        if (trb_shm_pop(&cons, &v) == 0) {
+            TRB_CHECK(v == expect);
+            expect++;
+        } else {
+            sched_yield();
+        }
+    }
+    TRB_CHECK(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    trb_shm_detach(&cons);
+    TRB_CHECK(trb_shm_unlink(shm_name) == 0);
+}
+
+int main(void)
+{
+    snprintf(shm_name, sizeof(shm_name), "/trb_test_%ld", (long)getpid());
+    printf("test_tiny_rb_shm\n");
+    TRB_RUN(test_create_attach_checks);
+    TRB_RUN(test_attach_mismatch);
+    TRB_RUN(test_two_handles);
+    TRB_RUN(test_cached_layout);
+    TRB_RUN(test_forked_producer);
+    return 0;
+}
@@ -0,0 +1,109 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_soa.c
+ *
+ * \brief Tests for tiny_rb_soa.h: record scatter/gather across the wrap,
+ *        full/empty, per-column access and spans, and the column
+ *        reductions with tiny_rb_reduce.h.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_reduce.h"
+#include "tiny_rb_soa.h"
+
+typedef struct {
+    int32_t id;
+    float   level;
+    char    tag;
+} rec_t;
+
+#define REC_FIELDS(X, A)\
+    X(int32_t, id, A)\
+    X(float, level, A)\
+    X(char, tag, A)
+
+TRB_SOA_DEFINE_STATIC(rec_t, soa, 10, REC_FIELDS);
+
+static rec_t make_rec(int32_t i)
+{
+    rec_t r;
+
+    r.id = i;
+    r.level = (float)i * 0.5f;
+    r.tag = (char)('a' + i % 26);
+    return r;
+}
+
+static void test_wrap_full_empty(void)
+{
+    rec_t r;
+    int32_t i, next = 0, expect = 0;
+    int round;
+
+    TRB_CHECK(trb_soa_pop(soa, &r) == -1 && trb_soa_peek(soa, &r) == -1);
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 10; i++, next++) {
+            r = make_rec(next);
+            TRB_CHECK(trb_soa_push(soa, &r) == 0);
+        }
+        TRB_CHECK(trb_soa_push(soa, &r) == -1 && trb_is_full(soa));
+        for (i = 0; i < 7; i++, expect++) {
+            TRB_CHECK(trb_soa_peek(soa, &r) == 0 && r.id == expect);
+            TRB_CHECK(trb_soa_pop(soa, &r) == 0 && r.id == expect);
+            TRB_CHECK(r.level == (float)expect * 0.5f && r.tag == (char)('a' + expect % 26));
+        }
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_soa_pop(soa, &r) == 0 && r.id == expect);
+        }
+        TRB_CHECK(trb_is_empty(soa));
+        /* Leave the next round starting at a different offset */
+        r = make_rec(next++);
+        TRB_CHECK(trb_soa_push(soa, &r) == 0);
+        TRB_CHECK(trb_soa_pop(soa, &r) == 0 && r.id == expect++);
+    }
+}
+
+static void test_columns(void)
+{
+    const int32_t *p1, *p2;
+    size_t l1, l2;
+    int32_t i, mn, mx;
+    rec_t r;
+
+    TRB_CHECK(trb_soa_spans(soa, id, &p1, &l1, &p2, &l2) == 0 && l1 == 0 && l2 == 0);
+    TRB_CHECK(trb_soa_minmax(soa, id, &mn, &mx) == -1 && trb_soa_mean(soa, level) == 0.0);
+    for (i = 0; i < 25; i++) {
+        r = make_rec(i);
+        trb_soa_force_push(soa, &r);
+    }
+    /* Ids 15 .. 24 live; head is not at slot 0 */
+    TRB_CHECK(trb_size(soa) == 10 && trb_soa_sum(soa, id) == 195);
+    TRB_CHECK(trb_soa_minmax(soa, id, &mn, &mx) == 0 && mn == 15 && mx == 24);
+    TRB_CHECK(trb_soa_mean(soa, level) == 19.5 * 0.5);
+    TRB_CHECK(trb_soa_spans(soa, id, &p1, &l1, &p2, &l2) >= 1 && l1 + l2 == 10 && *p1 == 15);
+    TRB_CHECK(l2 == 0 || *p2 == 15 + (int32_t)l1);
+    TRB_CHECK(*trb_soa_at(soa, tag, 0) == 'p' && *trb_soa_at(soa, id, 9) == 24);
+    TRB_CHECK(trb_soa_at(soa, id, 10) == NULL);
+    trb_flush(soa);
+    TRB_CHECK(trb_is_empty(soa) && trb_soa_sum(soa, id) == 0);
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_soa\n");
+    TRB_RUN(test_wrap_full_empty);
+    TRB_RUN(test_columns);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_spsc.c
+ *
+ * \brief Tests for tiny_rb_spsc.h: full/empty across the counter wrap,
+ *        batched pushes and a threaded producer/consumer sequence check.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+
+#define TRB_SPSC_BATCH 4
+#include "tiny_rb_spsc.h"
+
+#define STRESS_ITEMS 200000u
+
+TRB_SPSC_DEFINE_STATIC(uint32_t, q, 8);
+TRB_SPSC_DEFINE_STATIC(uint32_t, stress, 64);
+
+static void test_full_empty_wrap(void)
+{
+    uint32_t v, i, next = 0, expect = 0;
+    int round;
+
+    TRB_CHECK(trb_spsc_is_empty(q) && trb_spsc_capacity(q) == 8);
+    TRB_CHECK(trb_spsc_pop(q, &v) == -1 && trb_spsc_peek(q, &v) == -1);
+    for (round = 0; round < 10; round++) {
+        for (i = 0; i < 8; i++, next++) {
+            TRB_CHECK(trb_spsc_push(q, &next) == 0);
+        }
+        TRB_CHECK(trb_spsc_is_full(q) && trb_spsc_push(q, &next) == -1);
+        TRB_CHECK(trb_spsc_peek(q, &v) == 0 && v == expect);
+        for (i = 0; i < 5; i++, expect++) {
+            TRB_CHECK(trb_spsc_pop(q, &v) == 0 && v == expect);
+        }
+        TRB_CHECK(trb_spsc_size(q) == 3);
+        for (i = 0; i < 3; i++, expect++) {
+            TRB_CHECK(trb_spsc_pop(q, &v) == 0 && v == expect);
+        }
+        TRB_CHECK(trb_spsc_pop(q, &v) == -1);
+    }
+}
+
+static void test_push_local(void)
+{
+    uint32_t v, i;
+
+    for (i = 0; i < 3; i++) {
+        TRB_CHECK(trb_spsc_push_local(q, &i) == 0);
+    }
+    /* Staged but not yet published */
+    TRB_CHECK(trb_spsc_pop(q, &v) == -1);
+    TRB_CHECK(trb_spsc_push_local(q, &i) == 0);        /* Fourth publishes */
+    TRB_CHECK(trb_spsc_size(q) == 4);
+    i = 4;
+    TRB_CHECK(trb_spsc_push_local(q, &i) == 0);
+    trb_spsc_flush(q);
+    for (i = 0; i < 5; i++) {
+        TRB_CHECK(trb_spsc_pop(q, &v) == 0 && v == i);
+    }
+    TRB_CHECK(trb_spsc_is_empty(q));
+}
+
+static void *producer(void *arg)
+{
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        if (i & 1) {
+            while (trb_spsc_push_local(stress, &i) != 0) {
+                sched_yield();
+            }
+        } else {
+            while (trb_spsc_push(stress, &i) != 0) {
+                sched_yield();
+            }
+        }
+    }
+    trb_spsc_flush(stress);
+    return NULL;
+}
+
+static void test_threaded_sequence(void)
+{
+    pthread_t th;
+    uint32_t v, expect = 0;
+
+    TRB_CHECK(pthread_create(&th, NULL, producer, NULL) == 0);
+    while (expect < STRESS_ITEMS) {
+        if (trb_spsc_pop(stress, &v) == 0) {
+            TRB_CHECK(v == expect);
+            expect++;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join(th, NULL);
+    TRB_CHECK(trb_spsc_is_empty(stress));
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_spsc\n");
+    TRB_RUN(test_full_empty_wrap);
+    TRB_RUN(test_push_local);
+    TRB_RUN(test_threaded_sequence);
+    return 0;
+}
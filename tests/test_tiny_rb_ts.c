@@ -0,0 +1,83 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_ts.c
+ *
+ * \brief Tests for tiny_rb_ts.h: ordering checks on push, force push across
+ *        the wrap, and trb_range_by_time against a linear scan for every
+ *        range over a window with duplicate timestamps.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_ts.h"
+
+TRB_TS_DEFINE_STATIC(uint32_t, ts, 6);
+
+static void test_push_order(void)
+{
+    uint32_t v = 1;
+
+    TRB_CHECK(trb_ts_pop(ts, &v) == -1);
+    TRB_CHECK(trb_ts_push(ts, &v, 10) == 0);
+    TRB_CHECK(trb_ts_push(ts, &v, 10) == 0);            /* Equal is fine */
+    TRB_CHECK(trb_ts_push(ts, &v, 9) == -1);            /* Older is not */
+    TRB_CHECK(trb_ts_force_push(ts, &v, 9) == -1 && trb_size(ts) == 2);
+    trb_flush(ts);
+    /* Once empty, any timestamp is accepted again */
+    TRB_CHECK(trb_ts_push(ts, &v, 3) == 0);
+    trb_flush(ts);
+}
+
+static void test_range_model(void)
+{
+    uint32_t v, next = 0;
+    uint64_t stamp = 100;
+    int step;
+
+    for (step = 0; step < 40; step++, next++) {
+        trb_ts_span_t span;
+        uint64_t t0, t1;
+        size_t i, n;
+
+        stamp += (uint64_t)(step % 3 == 0 ? 0 : step % 4);  /* Repeats and gaps */
+        TRB_CHECK(trb_ts_force_push(ts, &next, stamp) == 0);
+        if (step % 5 == 4) {
+            TRB_CHECK(trb_ts_pop(ts, &v) == 0 && v == next - trb_size(ts));
+        }
+        n = trb_size(ts);
+        TRB_CHECK(n <= 6 && *trb_at(ts, n - 1) == next && trb_ts_stamp(ts, n - 1) == stamp);
+        /* Every range around the live window, including empty and reversed ones */
+        for (t0 = trb_ts_stamp(ts, 0) - 1; t0 <= stamp + 1; t0++) {
+            for (t1 = t0 - 1; t1 <= stamp + 1; t1++) {
+                size_t first = n, cnt = 0;
+
+                for (i = 0; i < n; i++) {
+                    if (trb_ts_stamp(ts, i) >= t0 && trb_ts_stamp(ts, i) <= t1) {
+                        first = (cnt++ == 0) ? i : first;
+                    }
+                }
+                TRB_CHECK(trb_range_by_time(ts, t0, t1, &span) == cnt && span.count == cnt);
+                TRB_CHECK(cnt == 0 || span.first == first);
+            }
+        }
+    }
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_ts\n");
+    TRB_RUN(test_push_order);
+    TRB_RUN(test_range_model);
+    return 0;
+}
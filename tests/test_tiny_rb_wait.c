@@ -0,0 +1,149 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_wait.c
+ *
+ * \brief Tests for tiny_rb_wait.h: timeouts on empty and full buffers,
+ *        staged elements published by push_wait, a threaded blocking
+ *        producer/consumer sequence check with a small buffer so both sides
+ *        park, and plain push/pop waking a parked peer.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "trb_test.h"
+
+#define TRB_WAIT_SPIN 4
+#include "tiny_rb_wait.h"
+
+#define STRESS_ITEMS 100000u
+
+TRB_SPSC_DEFINE_STATIC(uint32_t, q, 4);
+TRB_SPSC_DEFINE_STATIC(uint32_t, stress, 2);
+TRB_SPSC_DEFINE_STATIC(uint32_t, mixed, 2);
+
+static void test_timeouts(void)
+{
+    uint64_t t0;
+    uint32_t v = 0;
+    int i;
+
+    TRB_CHECK(trb_spsc_pop_wait(q, &v, 0) == -1);
+    t0 = _trb_wait_now_ms();
+    TRB_CHECK(trb_spsc_pop_wait(q, &v, 30) == -1);
+    TRB_CHECK(_trb_wait_now_ms() - t0 >= 29);
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_spsc_push_wait(q, &v, 0) == 0);
+    }
+    TRB_CHECK(trb_spsc_push_wait(q, &v, 0) == -1);
+    TRB_CHECK(trb_spsc_push_wait(q, &v, 10) == -1);
+    for (i = 0; i < 4; i++) {
+        TRB_CHECK(trb_spsc_pop_wait(q, &v, TRB_WAIT_FOREVER) == 0);
+    }
+}
+
+static void test_staged_published(void)
+{
+    uint32_t v, i;
+
+    for (i = 0; i < 2; i++) {
+        TRB_CHECK(trb_spsc_push_local(q, &i) == 0);
+    }
+    TRB_CHECK(trb_spsc_push_wait(q, &i, 0) == 0);
+    /* Staged elements go out first, in order */
+    for (i = 0; i < 3; i++) {
+        TRB_CHECK(trb_spsc_pop_wait(q, &v, 0) == 0 && v == i);
+    }
+    TRB_CHECK(trb_spsc_is_empty(q));
+}
+
+static void *producer(void *arg)
+{
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        TRB_CHECK(trb_spsc_push_wait(stress, &i, TRB_WAIT_FOREVER) == 0);
+    }
+    return NULL;
+}
+
+static void test_threaded_blocking(void)
+{
+    pthread_t th;
+    uint32_t v, i;
+
+    TRB_CHECK(pthread_create(&th, NULL, producer, NULL) == 0);
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        TRB_CHECK(trb_spsc_pop_wait(stress, &v, TRB_WAIT_FOREVER) == 0 && v == i);
+    }
+    pthread_join(th, NULL);
+    TRB_CHECK(trb_spsc_is_empty(stress));
+}
+
+static void *plain_producer(void *arg)
+{
+    uint32_t i;
+
+    (void)arg;
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        while (trb_spsc_push(mixed, &i) != 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *plain_consumer(void *arg)
+{
+    uint32_t v, i;
+
+    (void)arg;
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        while (trb_spsc_pop(mixed, &v) != 0) {
+            sched_yield();
+        }
+        TRB_CHECK(v == i);
+    }
+    return NULL;
+}
+
+/* A parked waiter must be woken by the plain calls on the other side */
+static void test_plain_wakes_waiter(void)
+{
+    pthread_t th;
+    uint32_t v, i;
+
+    TRB_CHECK(pthread_create(&th, NULL, plain_producer, NULL) == 0);
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        TRB_CHECK(trb_spsc_pop_wait(mixed, &v, TRB_WAIT_FOREVER) == 0 && v == i);
+    }
+    pthread_join(th, NULL);
+
+    TRB_CHECK(pthread_create(&th, NULL, plain_consumer, NULL) == 0);
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        TRB_CHECK(trb_spsc_push_wait(mixed, &i, TRB_WAIT_FOREVER) == 0);
+    }
+    pthread_join(th, NULL);
+    TRB_CHECK(trb_spsc_is_empty(mixed));
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_wait\n");
+    TRB_RUN(test_timeouts);
+    TRB_RUN(test_staged_published);
+    TRB_RUN(test_threaded_blocking);
+    TRB_RUN(test_plain_wakes_waiter);
+    return 0;
+}
@@ -0,0 +1,125 @@
+/******************************************************************************/
+/**
+ * \file  test_tiny_rb_ws.c
+ *
+ * \brief Tests for tiny_rb_ws.h: owner LIFO / thief FIFO ends, full/empty
+ *        across the index wrap, and a threaded run where the owner races
+ *        several thieves and every element must be taken exactly once.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "trb_test.h"
+#include "tiny_rb_ws.h"
+
+#define THIEVES      3
+#define STRESS_ITEMS 200000u
+
+TRB_WS_DEFINE_STATIC(uint32_t, dq, 4);
+TRB_WS_DEFINE_STATIC(uint32_t, stress, 256);
+
+static atomic_uchar taken[STRESS_ITEMS];
+static atomic_int owner_done;
+
+static void test_ends_wrap(void)
+{
+    uint32_t v, i, next = 0;
+    int round;
+
+    TRB_CHECK(trb_ws_is_empty(dq) && trb_ws_capacity(dq) == 4);
+    TRB_CHECK(trb_ws_pop(dq, &v) == -1 && trb_ws_steal(dq, &v) == -1);
+    for (round = 0; round < 10; round++) {
+        uint32_t first = next;
+
+        for (i = 0; i < 4; i++, next++) {
+            TRB_CHECK(trb_ws_push(dq, &next) == 0);
+        }
+        TRB_CHECK(trb_ws_push(dq, &next) == -1 && trb_ws_size(dq) == 4);
+        /* Thieves take the oldest, the owner the newest */
+        TRB_CHECK(trb_ws_steal(dq, &v) == 0 && v == first);
+        TRB_CHECK(trb_ws_pop(dq, &v) == 0 && v == first + 3);
+        TRB_CHECK(trb_ws_steal(dq, &v) == 0 && v == first + 1);
+        TRB_CHECK(trb_ws_pop(dq, &v) == 0 && v == first + 2);
+        TRB_CHECK(trb_ws_pop(dq, &v) == -1 && trb_ws_steal(dq, &v) == -1);
+        TRB_CHECK(trb_ws_size(dq) == 0);
+    }
+}
+
+static void take(uint32_t v)
+{
+    TRB_CHECK(v < STRESS_ITEMS);
+    TRB_CHECK(atomic_fetch_add(&taken[v], 1) == 0);
+}
+
+static void *thief(void *arg)
+{
+    uint32_t v;
+
+    (void)arg;
+    for (;;) {
+        int ret = trb_ws_steal(stress, &v);
+
+        if (ret == 0) {
+            take(v);
+        } else if (ret == -1) {
+            if (atomic_load(&owner_done)) {
+                break;
+            }
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void test_threaded_exactly_once(void)
+{
+    pthread_t th[THIEVES];
+    uint32_t i, v;
+    int k;
+
+    for (k = 0; k < THIEVES; k++) {
+        TRB_CHECK(pthread_create(&th[k], NULL, thief, NULL) == 0);
+    }
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        while (trb_ws_push(stress, &i) != 0) {
+            if (trb_ws_pop(stress, &v) == 0) {
+                take(v);
+            }
+        }
+        /* Keep the owner end busy too, so pops race steals on the last element */
+        if ((i % 3) == 0 && trb_ws_pop(stress, &v) == 0) {
+            take(v);
+        }
+    }
+    while (trb_ws_pop(stress, &v) == 0) {
+        take(v);
+    }
+    atomic_store(&owner_done, 1);
+    for (k = 0; k < THIEVES; k++) {
+        pthread_join(th[k], NULL);
+    }
+    TRB_CHECK(trb_ws_is_empty(stress));
+    for (i = 0; i < STRESS_ITEMS; i++) {
+        TRB_CHECK(atomic_load(&taken[i]) == 1);
+    }
+}
+
+int main(void)
+{
+    printf("test_tiny_rb_ws\n");
+    TRB_RUN(test_ends_wrap);
+    TRB_RUN(test_threaded_exactly_once);
+    return 0;
+}
@@ -0,0 +1,46 @@
+/******************************************************************************/
+/**
+ * \file  trb_test.h
+ *
+ * \brief Minimal check macros shared by the tiny_rb tests. A failed check
+ *        prints its location and condition and exits with status 1, so
+ *        every test program is a plain executable run by `make test`.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TRB_TEST_H__
+#define __TRB_TEST_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * \brief   Abort the test program unless COND holds
+ */
+#define TRB_CHECK(COND)\
+    do {\
+        if (!(COND)) {\
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND);\
+            exit(1);\
+        }\
+    } while (0)
+
+/**
+ * \brief   Run one test function and report it
+ */
+#define TRB_RUN(FN)\
+    do {\
+        FN();\
+        printf("  %-32s ok\n", #FN);\
+    } while (0)
+
+#endif /* __TRB_TEST_H__ */
@@ -22,6 +22,116 @@
 #include <stddef.h>
 #include <string.h>
 
+/**
+ * \brief   Cache line size used to separate fields written by different cores
+ */
+#ifndef TRB_CACHELINE_SIZE
+#define TRB_CACHELINE_SIZE 64
+#endif
+
+/**
+ * \brief   Portable alignment specifier for struct members
+ */
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define TRB_ALIGNAS(N) alignas(N)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define TRB_ALIGNAS(N) _Alignas(N)
+#elif defined(__GNUC__)
+#define TRB_ALIGNAS(N) __attribute__((aligned(N)))
+#else
+#define TRB_ALIGNAS(N)
+#endif
+
+/**
+ * \brief   Define TRB_CACHELINE before including this header to lay out ring
+ *          buffers with capacity, head, tail and the element storage each on
+ *          their own cache line. This avoids false sharing between the core
+ *          writing head and the core writing tail, and aligns buf for SIMD
+ *          copies, at the cost of a few cache lines of padding per buffer.
+ */
+#ifdef TRB_CACHELINE
+#define _TRB_CL TRB_ALIGNAS(TRB_CACHELINE_SIZE)
+#else
+#define _TRB_CL
+#endif
+
+/**
+ * \brief   Snapshot of the counters kept when TRB_ENABLE_STATS is defined
+ *
+ *          Bulk and zero-copy operations count per element.
+ */
+typedef struct {
+    size_t peak;        /**< Highest element count observed */
+    size_t pushes;      /**< Elements pushed (including force pushes) */
+    size_t pops;        /**< Elements popped or released */
+    size_t rejected;    /**< Elements not pushed because the buffer was full */
+    size_t overwritten; /**< Oldest elements dropped by force push */
+    size_t underflows;  /**< Elements not popped because the buffer was empty */
+} trb_stats_t;
+
+/**
+ * \brief   Define TRB_ENABLE_STATS before including this header to keep
+ *          trb_stats_t counters in every TRB_RB_DEFINE / TRB_RB_DEFINE_POW2
+ *          buffer. When it is not defined the hooks below expand to nothing.
+ */
+#ifdef TRB_ENABLE_STATS
+#define _TRB_STATS_FIELD trb_stats_t stats;
+#define _TRB_STATS_PTR(NAME) (&_trb_##NAME##_buf.stats)
+#define _TRB_STAT_ADD(NAME, FIELD, N) ((void)(_trb_##NAME##_buf.stats.FIELD += (N)))
+#define _TRB_STAT_PEAK(NAME, SIZE)\
+    ((SIZE) > _trb_##NAME##_buf.stats.peak ? (void)(_trb_##NAME##_buf.stats.peak = (SIZE)) : (void)0)
+#else
+#define _TRB_STATS_FIELD
+#define _TRB_STATS_PTR(NAME) ((trb_stats_t *)NULL)
+#define _TRB_STAT_ADD(NAME, FIELD, N) ((void)0)
+#define _TRB_STAT_PEAK(NAME, SIZE) ((void)0)
+#endif
+
+/**
+ * \brief   Operation codes passed to TRB_TRACE_HOOK
+ */
+#define TRB_TRACE_PUSH       0  /**< Element pushed */
+#define TRB_TRACE_POP        1  /**< Element popped */
+#define TRB_TRACE_FORCE_PUSH 2  /**< Element pushed by force push */
+#define TRB_TRACE_PUSH_FULL  3  /**< Push rejected, buffer full */
+#define TRB_TRACE_POP_EMPTY  4  /**< Pop failed, buffer empty */
+
+/**
+ * \brief   Optional trace points in the FIFO and deque push/pop paths,
+ *          compiled out unless enabled before including this header:
+ *
+ *          - TRB_TRACE_HOOK(NAME_STR, OP, DEPTH): user macro or function
+ *            called with the buffer name as a string, a TRB_TRACE_* code
+ *            and the element count after the operation.
+ *          - TRB_TRACE_USDT: Linux USDT probes (needs <sys/sdt.h> and a
+ *            GNU-compatible compiler) named tiny_rb:push, tiny_rb:pop,
+ *            tiny_rb:force_push, tiny_rb:push_full and tiny_rb:pop_empty,
+ *            with arguments (name, depth, capacity). A probe is a single
+ *            nop until perf or bpftrace attaches to it.
+ */
+#ifdef TRB_TRACE_USDT
+#include <sys/sdt.h>
+#define _TRB_TRACE_USDT(NAME, PROBE, DEPTH)\
+    __extension__ ({ DTRACE_PROBE3(tiny_rb, PROBE, #NAME, (size_t)(DEPTH), (size_t)_trb_##NAME##_buf.capacity); })
+#else
+#define _TRB_TRACE_USDT(NAME, PROBE, DEPTH) ((void)0)
+#endif
+
+#ifdef TRB_TRACE_HOOK
+#define _TRB_TRACE_USER(NAME, OP, DEPTH) ((void)TRB_TRACE_HOOK(#NAME, OP, (size_t)(DEPTH)))
+#else
+#define _TRB_TRACE_USER(NAME, OP, DEPTH) ((void)0)
+#endif
+
+#if defined(TRB_TRACE_HOOK) && defined(TRB_TRACE_USDT)
+#define _TRB_TRACE(NAME, PROBE, OP, DEPTH)\
+    (_TRB_TRACE_USER(NAME, OP, DEPTH), _TRB_TRACE_USDT(NAME, PROBE, DEPTH))
+#elif defined(TRB_TRACE_HOOK)
+#define _TRB_TRACE(NAME, PROBE, OP, DEPTH) _TRB_TRACE_USER(NAME, OP, DEPTH)
+#else
+#define _TRB_TRACE(NAME, PROBE, OP, DEPTH) _TRB_TRACE_USDT(NAME, PROBE, DEPTH)
+#endif
+
 /**
  * \brief   Declare a global ring buffer
  *
@@ -31,11 +141,12 @@
  */
 #define TRB_RB_DEFINE(TYPE, NAME, CAPACITY)\
     struct {\
-        size_t capacity;\
-        size_t head;\
-        size_t tail;\
-        size_t count;\
-        TYPE   buf[CAPACITY];\
+        _TRB_CL size_t capacity;\
+        _TRB_CL size_t head;\
+        _TRB_CL size_t tail;\
+        _TRB_CL size_t count;\
+        _TRB_STATS_FIELD\
+        _TRB_CL TYPE   buf[CAPACITY];\
     } _trb_##NAME##_buf = {\
         .capacity = CAPACITY,\
         .head = 0,\
@@ -61,11 +172,72 @@
  */
 #define TRB_RB_IMPORT(TYPE, NAME)\
     extern struct {\
-        size_t capacity;\
-        size_t head;\
-        size_t tail;\
-        size_t count;\
-        TYPE   buf[];\
+        _TRB_CL size_t capacity;\
+        _TRB_CL size_t head;\
+        _TRB_CL size_t tail;\
+        _TRB_CL size_t count;\
+        _TRB_STATS_FIELD\
+        _TRB_CL TYPE   buf[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Evaluate to CAPACITY if it is a non-zero power of two, otherwise to
+ *          -1 so that the array declaration using it fails to compile
+ */
+#define _TRB_POW2_CHECK(CAPACITY)\
+    ((((CAPACITY) > 0) && ((((CAPACITY) - 1) & (CAPACITY)) == 0)) ? (CAPACITY) : -1)
+
+/**
+ * \brief   Declare a global ring buffer whose capacity is a power of two
+ *
+ *          Indices wrap with a mask instead of a modulo, and head/tail are
+ *          free-running counters so no separate element count is kept.
+ *          Use the trb_pow2_* operations on buffers declared this way.
+ *          A CAPACITY that is not a power of two is rejected at compile time.
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_RB_DEFINE_POW2(TYPE, NAME, CAPACITY)\
+    struct {\
+        _TRB_CL size_t capacity;\
+        size_t mask;\
+        _TRB_CL size_t head;\
+        _TRB_CL size_t tail;\
+        _TRB_STATS_FIELD\
+        _TRB_CL TYPE   buf[_TRB_POW2_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1,\
+        .head = 0,\
+        .tail = 0\
+    }
+
+/**
+ * \brief   Declare a static ring buffer whose capacity is a power of two
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_RB_DEFINE_POW2_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_RB_DEFINE_POW2(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global ring buffer declared with TRB_RB_DEFINE_POW2
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_RB_IMPORT_POW2(TYPE, NAME)\
+    extern struct {\
+        _TRB_CL size_t capacity;\
+        size_t mask;\
+        _TRB_CL size_t head;\
+        _TRB_CL size_t tail;\
+        _TRB_STATS_FIELD\
+        _TRB_CL TYPE   buf[];\
     } _trb_##NAME##_buf
 
 /**
@@ -142,10 +314,13 @@
  *          - (-1) Buffer full
  */
 #define trb_fifo_push(NAME, VALUE_PTR)\
-    (trb_is_full(NAME)?(-1):\
+    (trb_is_full(NAME)?(_TRB_STAT_ADD(NAME, rejected, 1),\
+    _TRB_TRACE(NAME, push_full, TRB_TRACE_PUSH_FULL, _trb_##NAME##_buf.count), (-1)):\
     (memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
     _trb_##NAME##_buf.tail = (_trb_##NAME##_buf.tail + 1) % _trb_##NAME##_buf.capacity,\
-    _trb_##NAME##_buf.count++, (0)))
+    _trb_##NAME##_buf.count++,\
+    _TRB_STAT_ADD(NAME, pushes, 1), _TRB_STAT_PEAK(NAME, _trb_##NAME##_buf.count),\
+    _TRB_TRACE(NAME, push, TRB_TRACE_PUSH, _trb_##NAME##_buf.count), (0)))
 
 /**
  * \brief   Push an element, overwriting the oldest element if the buffer is full
@@ -159,9 +334,13 @@
         _trb_##NAME##_buf.tail = (_trb_##NAME##_buf.tail + 1) % _trb_##NAME##_buf.capacity;\
         if (trb_is_full(NAME)) {\
             _trb_##NAME##_buf.head = (_trb_##NAME##_buf.head + 1) % _trb_##NAME##_buf.capacity;\
+            _TRB_STAT_ADD(NAME, overwritten, 1);\
         } else {\
             _trb_##NAME##_buf.count++;\
+            _TRB_STAT_PEAK(NAME, _trb_##NAME##_buf.count);\
         }\
+        _TRB_STAT_ADD(NAME, pushes, 1);\
+        _TRB_TRACE(NAME, force_push, TRB_TRACE_FORCE_PUSH, _trb_##NAME##_buf.count);\
     } while (0)
 
 /**
@@ -174,10 +353,12 @@
  *          - (-1) Buffer empty
  */
 #define trb_fifo_pop(NAME, VALUE_PTR)\
-    (trb_is_empty(NAME)?(-1):\
+    (trb_is_empty(NAME)?(_TRB_STAT_ADD(NAME, underflows, 1),\
+    _TRB_TRACE(NAME, pop_empty, TRB_TRACE_POP_EMPTY, 0), (-1)):\
     (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], sizeof(_trb_##NAME##_buf.buf[0])),\
     _trb_##NAME##_buf.head = (_trb_##NAME##_buf.head + 1) % _trb_##NAME##_buf.capacity,\
-    _trb_##NAME##_buf.count--, (0)))
+    _trb_##NAME##_buf.count--,\
+    _TRB_STAT_ADD(NAME, pops, 1), _TRB_TRACE(NAME, pop, TRB_TRACE_POP, _trb_##NAME##_buf.count), (0)))
 
 /**
  * \brief   Peek at the front element without removing it
@@ -194,7 +375,127 @@
     (0)))
 
 /**
- * \brief   Push an element into the buffer
+ * \brief   Take a snapshot of the buffer counters
+ *
+ *          Works on TRB_RB_DEFINE and TRB_RB_DEFINE_POW2 buffers. Without
+ *          TRB_ENABLE_STATS the snapshot is all zeroes.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] OUT_PTR   Pointer to a trb_stats_t receiving the snapshot
+ */
+#ifdef TRB_ENABLE_STATS
+#define trb_stats(NAME, OUT_PTR)\
+    memcpy(OUT_PTR, &_trb_##NAME##_buf.stats, sizeof(trb_stats_t))
+#else
+#define trb_stats(NAME, OUT_PTR)\
+    memset(OUT_PTR, 0, sizeof(trb_stats_t))
+#endif
+
+/**
+ * \brief   Reset the buffer counters to zero
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#ifdef TRB_ENABLE_STATS
+#define trb_stats_reset(NAME)\
+    memset(&_trb_##NAME##_buf.stats, 0, sizeof(trb_stats_t))
+#else
+#define trb_stats_reset(NAME)\
+    ((void)0)
+#endif
+
+/**
+ * \brief   Push an element at the back of the buffer (same as trb_fifo_push)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_push_back(NAME, VALUE_PTR)\
+    trb_fifo_push(NAME, VALUE_PTR)
+
+/**
+ * \brief   Push an element at the front of the buffer, ahead of the oldest one
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_push_front(NAME, VALUE_PTR)\
+    (trb_is_full(NAME)?(_TRB_STAT_ADD(NAME, rejected, 1),\
+    _TRB_TRACE(NAME, push_full, TRB_TRACE_PUSH_FULL, _trb_##NAME##_buf.count), (-1)):\
+    (_trb_##NAME##_buf.head = (_trb_##NAME##_buf.head == 0 ? _trb_##NAME##_buf.capacity : _trb_##NAME##_buf.head) - 1,\
+    memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_##NAME##_buf.count++,\
+    _TRB_STAT_ADD(NAME, pushes, 1), _TRB_STAT_PEAK(NAME, _trb_##NAME##_buf.count),\
+    _TRB_TRACE(NAME, push, TRB_TRACE_PUSH, _trb_##NAME##_buf.count), (0)))
+
+/**
+ * \brief   Pop the element at the front of the buffer (same as trb_fifo_pop)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_pop_front(NAME, VALUE_PTR)\
+    trb_fifo_pop(NAME, VALUE_PTR)
+
+/**
+ * \brief   Pop the element at the back of the buffer (the newest one)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_pop_back(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(_TRB_STAT_ADD(NAME, underflows, 1),\
+    _TRB_TRACE(NAME, pop_empty, TRB_TRACE_POP_EMPTY, 0), (-1)):\
+    (_trb_##NAME##_buf.tail = (_trb_##NAME##_buf.tail == 0 ? _trb_##NAME##_buf.capacity : _trb_##NAME##_buf.tail) - 1,\
+    memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail], sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_##NAME##_buf.count--,\
+    _TRB_STAT_ADD(NAME, pops, 1), _TRB_TRACE(NAME, pop, TRB_TRACE_POP, _trb_##NAME##_buf.count), (0)))
+
+/**
+ * \brief   Peek at the front element without removing it (same as
+ *          trb_fifo_peek)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_peek_front(NAME, VALUE_PTR)\
+    trb_fifo_peek(NAME, VALUE_PTR)
+
+/**
+ * \brief   Peek at the back element without removing it
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_peek_back(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[(_trb_##NAME##_buf.tail == 0 ? _trb_##NAME##_buf.capacity : _trb_##NAME##_buf.tail) - 1],\
+            sizeof(_trb_##NAME##_buf.buf[0])),\
+    (0)))
+
+/**
+ * \brief   Push an element onto the stack (the back of the buffer)
+ *
+ *          LIFO operations work on the back end and FIFO operations consume
+ *          from the front, so both can be mixed on the same buffer.
  *
  * \param   [in] NAME      Buffer name
  * \param   [in] VALUE_PTR Pointer to the element to be pushed
@@ -203,13 +504,10 @@
  *          - (-1) Buffer full
  */
 #define trb_lifo_push(NAME, VALUE_PTR)\
-    (trb_is_full(NAME)?(-1):\
-    (memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
-    _trb_##NAME##_buf.head++,\
-    _trb_##NAME##_buf.count++, (0)))
+    trb_push_back(NAME, VALUE_PTR)
 
 /**
- * \brief   Pop an element from the buffer
+ * \brief   Pop the element on top of the stack (the back of the buffer)
  *
  * \param   [in]  NAME      Buffer name
  * \param   [out] VALUE_PTR Pointer where the popped element will be stored
@@ -218,13 +516,10 @@
  *          - (-1) Buffer empty
  */
 #define trb_lifo_pop(NAME, VALUE_PTR)\
-    (trb_is_empty(NAME)?(-1):\
-    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head - 1], sizeof(_trb_##NAME##_buf.buf[0])),\
-    _trb_##NAME##_buf.head--,\
-    _trb_##NAME##_buf.count--, (0)))
+    trb_pop_back(NAME, VALUE_PTR)
 
 /**
- * \brief   Peek at the front element without removing it
+ * \brief   Peek at the element on top of the stack without removing it
  *
  * \param   [in]  NAME      Buffer name
  * \param   [out] VALUE_PTR Pointer where the element will be copied
@@ -233,8 +528,800 @@
  *          - (-1) Buffer empty
  */
 #define trb_lifo_peek(NAME, VALUE_PTR)\
-    (trb_is_empty(NAME)?(-1):\
-    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head - 1], sizeof(_trb_##NAME##_buf.buf[0])),\
+    trb_peek_back(NAME, VALUE_PTR)
+
+/**
+ * \brief   Copy up to n elements into the ring at tail, splitting at the wrap
+ *          point into at most two memcpy calls
+ *
+ * \param   [in]     buf       Element storage
+ * \param   [in]     esize     Size of one element in bytes
+ * \param   [in]     capacity  Capacity of the buffer in elements
+ * \param   [in,out] tail      Tail index of the buffer
+ * \param   [in,out] count     Element count of the buffer
+ * \param   [in]     src       Elements to copy in
+ * \param   [in]     n         Number of elements requested
+ * \param   [in,out] stats     Counters to update, or NULL
+ *
+ * \return  Number of elements actually copied
+ */
+static inline size_t _trb_push_n(void *buf, size_t esize, size_t capacity,
+                                 size_t *tail, size_t *count,
+                                 const void *src, size_t n, trb_stats_t *stats)
+{
+    size_t first;
+
+    if (n > capacity - *count) {
+        if (stats != NULL) {
+            stats->rejected += n - (capacity - *count);
+        }
+        n = capacity - *count;
+    }
+    first = capacity - *tail;
+    if (first > n) {
+        first = n;
+    }
+    memcpy((char *)buf + *tail * esize, src, first * esize);
+    memcpy(buf, (const char *)src + first * esize, (n - first) * esize);
+    *tail += n;
+    if (*tail >= capacity) {
+        *tail -= capacity;
+    }
+    *count += n;
+    if (stats != NULL) {
+        stats->pushes += n;
+        if (*count > stats->peak) {
+            stats->peak = *count;
+        }
+    }
+    return n;
+}
+
+/**
+ * \brief   Copy up to n elements out of the ring at head, splitting at the
+ *          wrap point into at most two memcpy calls
+ *
+ * \param   [in]     buf       Element storage
+ * \param   [in]     esize     Size of one element in bytes
+ * \param   [in]     capacity  Capacity of the buffer in elements
+ * \param   [in,out] head      Head index of the buffer
+ * \param   [in,out] count     Element count of the buffer
+ * \param   [out]    dst       Destination for the elements
+ * \param   [in]     n         Number of elements requested
+ * \param   [in,out] stats     Counters to update, or NULL
+ *
+ * \return  Number of elements actually copied
+ */
+static inline size_t _trb_pop_n(const void *buf, size_t esize, size_t capacity,
+                                size_t *head, size_t *count,
+                                void *dst, size_t n, trb_stats_t *stats)
+{
+    size_t first;
+
+    if (n > *count) {
+        if (stats != NULL) {
+            stats->underflows += n - *count;
+        }
+        n = *count;
+    }
+    first = capacity - *head;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(dst, (const char *)buf + *head * esize, first * esize);
+    memcpy((char *)dst + first * esize, buf, (n - first) * esize);
+    *head += n;
+    if (*head >= capacity) {
+        *head -= capacity;
+    }
+    *count -= n;
+    if (stats != NULL) {
+        stats->pops += n;
+    }
+    return n;
+}
+
+/**
+ * \brief   Push up to N elements into the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] SRC_PTR   Pointer to the first of the elements to be pushed
+ * \param   [in] N         Number of elements to push
+ *
+ * \return  Number of elements pushed (size_t), less than N if the buffer
+ *          fills up
+ */
+#define trb_fifo_push_n(NAME, SRC_PTR, N)\
+    _trb_push_n(_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0]), _trb_##NAME##_buf.capacity,\
+                &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.count, SRC_PTR, N, _TRB_STATS_PTR(NAME))
+
+/**
+ * \brief   Pop up to N elements from the buffer
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] DST_PTR   Pointer where the popped elements will be stored
+ * \param   [in]  N         Maximum number of elements to pop
+ *
+ * \return  Number of elements popped (size_t), less than N if the buffer
+ *          runs empty
+ */
+#define trb_fifo_pop_n(NAME, DST_PTR, N)\
+    _trb_pop_n(_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0]), _trb_##NAME##_buf.capacity,\
+               &_trb_##NAME##_buf.head, &_trb_##NAME##_buf.count, DST_PTR, N, _TRB_STATS_PTR(NAME))
+
+/**
+ * \brief   Number of slots usable in one contiguous run starting at idx
+ *
+ * \param   [in] capacity  Capacity of the buffer in elements
+ * \param   [in] idx       Starting index
+ * \param   [in] avail     Slots available in total (free or used)
+ * \param   [in] max       Upper bound requested by the caller
+ *
+ * \return  min(capacity - idx, avail, max)
+ */
+static inline size_t _trb_span(size_t capacity, size_t idx, size_t avail, size_t max)
+{
+    size_t n = capacity - idx;
+
+    if (n > avail) {
+        n = avail;
+    }
+    if (n > max) {
+        n = max;
+    }
+    return n;
+}
+
+/**
+ * \brief   Split count live elements starting at head into the run up to the
+ *          end of the storage and the wrapped-around remainder
+ *
+ * \param   [in]  capacity  Capacity of the buffer in elements
+ * \param   [in]  head      Index of the oldest element
+ * \param   [in]  count     Number of live elements
+ * \param   [out] len1      Receives the length of the first run
+ * \param   [out] len2      Receives the length of the second run
+ *
+ * \return  Number of non-empty runs (0, 1 or 2)
+ */
+static inline int _trb_spans(size_t capacity, size_t head, size_t count, size_t *len1, size_t *len2)
+{
+    *len1 = _trb_span(capacity, head, count, count);
+    *len2 = count - *len1;
+    return (*len1 != 0) + (*len2 != 0);
+}
+
+/**
+ * \brief   Reserve a contiguous free region at the tail for in-place writes
+ *
+ *          Nothing becomes visible to pop until trb_fifo_commit is called.
+ *          The region never wraps, so a second reserve may be needed after
+ *          committing to use the slots at the start of the storage.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR_PTR   Receives a pointer to the first reserved slot
+ * \param   [in]  MAX       Maximum number of slots wanted
+ *
+ * \return  Number of contiguous slots reserved (size_t), 0 if full
+ */
+#define trb_fifo_reserve(NAME, PTR_PTR, MAX)\
+    (*(PTR_PTR) = &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail],\
+    _trb_span(_trb_##NAME##_buf.capacity, _trb_##NAME##_buf.tail,\
+              _trb_##NAME##_buf.capacity - _trb_##NAME##_buf.count, MAX))
+
+/**
+ * \brief   Publish N slots written in place after trb_fifo_reserve
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] N         Number of slots to commit (at most the reserved count)
+ */
+#define trb_fifo_commit(NAME, N)\
+    do {\
+        size_t _trb_n = (N);\
+        _trb_##NAME##_buf.tail += _trb_n;\
+        if (_trb_##NAME##_buf.tail >= _trb_##NAME##_buf.capacity) {\
+            _trb_##NAME##_buf.tail -= _trb_##NAME##_buf.capacity;\
+        }\
+        _trb_##NAME##_buf.count += _trb_n;\
+        _TRB_STAT_ADD(NAME, pushes, _trb_n);\
+        _TRB_STAT_PEAK(NAME, _trb_##NAME##_buf.count);\
+    } while (0)
+
+/**
+ * \brief   Expose the contiguous run of elements at the head for in-place reads
+ *
+ *          The elements stay in the buffer until trb_fifo_release is called.
+ *          When the live data wraps, only the part up to the end of the
+ *          storage is returned; release it and peek again for the rest.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR_PTR   Receives a pointer to the oldest element
+ *
+ * \return  Number of contiguous elements readable (size_t), 0 if empty
+ */
+#define trb_fifo_peek_span(NAME, PTR_PTR)\
+    (*(PTR_PTR) = &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head],\
+    _trb_span(_trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head,\
+              _trb_##NAME##_buf.count, _trb_##NAME##_buf.count))
+
+/**
+ * \brief   Drop N elements read in place after trb_fifo_peek_span
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] N         Number of elements to release (at most the peeked count)
+ */
+#define trb_fifo_release(NAME, N)\
+    do {\
+        size_t _trb_n = (N);\
+        _trb_##NAME##_buf.head += _trb_n;\
+        if (_trb_##NAME##_buf.head >= _trb_##NAME##_buf.capacity) {\
+            _trb_##NAME##_buf.head -= _trb_##NAME##_buf.capacity;\
+        }\
+        _trb_##NAME##_buf.count -= _trb_n;\
+        _TRB_STAT_ADD(NAME, pops, _trb_n);\
+    } while (0)
+
+/**
+ * \brief   Wrap an index in [0, 2 * capacity) back into [0, capacity)
+ *          without a divide
+ */
+static inline size_t _trb_wrap(size_t idx, size_t capacity)
+{
+    return (idx >= capacity) ? (idx - capacity) : idx;
+}
+
+/**
+ * \brief   Get a pointer to the i-th oldest element without removing it
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] I         Index from the front, 0 is the oldest element
+ *
+ * \return  Pointer to the element, or NULL if I >= trb_size(NAME)
+ */
+#define trb_at(NAME, I)\
+    ((size_t)(I) < _trb_##NAME##_buf.count ?\
+    &_trb_##NAME##_buf.buf[_trb_wrap(_trb_##NAME##_buf.head + (size_t)(I), _trb_##NAME##_buf.capacity)] : NULL)
+
+/**
+ * \brief   Get the one or two contiguous regions holding the live elements,
+ *          oldest first, without removing them
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR1_PTR  Receives a pointer to the first region
+ * \param   [out] LEN1_PTR  Receives the number of elements in the first region
+ * \param   [out] PTR2_PTR  Receives a pointer to the second region
+ * \param   [out] LEN2_PTR  Receives the number of elements in the second region
+ *                          (0 when the live data does not wrap)
+ *
+ * \return  Number of non-empty regions (0, 1 or 2)
+ */
+#define trb_spans(NAME, PTR1_PTR, LEN1_PTR, PTR2_PTR, LEN2_PTR)\
+    (*(PTR1_PTR) = &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head],\
+    *(PTR2_PTR) = &_trb_##NAME##_buf.buf[0],\
+    _trb_spans(_trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head, _trb_##NAME##_buf.count,\
+               LEN1_PTR, LEN2_PTR))
+
+/**
+ * \brief   Get the number of elements currently in a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_pow2_size(NAME)\
+    ((size_t)(_trb_##NAME##_buf.tail - _trb_##NAME##_buf.head))
+
+/**
+ * \brief   Check if a power-of-two buffer is empty
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_pow2_is_empty(NAME)\
+    (_trb_##NAME##_buf.tail == _trb_##NAME##_buf.head)
+
+/**
+ * \brief   Check if a power-of-two buffer is full
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Full
+ *          - (0): Not full
+ */
+#define trb_pow2_is_full(NAME)\
+    (trb_pow2_size(NAME) == _trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the total capacity of a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_pow2_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the remaining free space in a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of free slots (size_t)
+ */
+#define trb_pow2_remaining(NAME)\
+    (_trb_##NAME##_buf.capacity - trb_pow2_size(NAME))
+
+/**
+ * \brief   Clear a power-of-two buffer (reset to empty state)
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_pow2_flush(NAME)\
+    do {\
+        _trb_##NAME##_buf.head = 0;\
+        _trb_##NAME##_buf.tail = 0;\
+    } while (0)
+
+/**
+ * \brief   Push an element into a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_pow2_fifo_push(NAME, VALUE_PTR)\
+    (trb_pow2_is_full(NAME)?(_TRB_STAT_ADD(NAME, rejected, 1),\
+    _TRB_TRACE(NAME, push_full, TRB_TRACE_PUSH_FULL, trb_pow2_size(NAME)), (-1)):\
+    (memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail & _trb_##NAME##_buf.mask], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_##NAME##_buf.tail++,\
+    _TRB_STAT_ADD(NAME, pushes, 1), _TRB_STAT_PEAK(NAME, trb_pow2_size(NAME)),\
+    _TRB_TRACE(NAME, push, TRB_TRACE_PUSH, trb_pow2_size(NAME)), (0)))
+
+/**
+ * \brief   Push an element into a power-of-two buffer, overwriting the oldest
+ *          element if the buffer is full
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ */
+#define trb_pow2_fifo_force_push(NAME, VALUE_PTR)\
+    do {\
+        if (trb_pow2_is_full(NAME)) {\
+            _trb_##NAME##_buf.head++;\
+            _TRB_STAT_ADD(NAME, overwritten, 1);\
+        }\
+        memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail & _trb_##NAME##_buf.mask], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]));\
+        _trb_##NAME##_buf.tail++;\
+        _TRB_STAT_ADD(NAME, pushes, 1);\
+        _TRB_STAT_PEAK(NAME, trb_pow2_size(NAME));\
+        _TRB_TRACE(NAME, force_push, TRB_TRACE_FORCE_PUSH, trb_pow2_size(NAME));\
+    } while (0)
+
+/**
+ * \brief   Pop an element from a power-of-two buffer
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_pow2_fifo_pop(NAME, VALUE_PTR)\
+    (trb_pow2_is_empty(NAME)?(_TRB_STAT_ADD(NAME, underflows, 1),\
+    _TRB_TRACE(NAME, pop_empty, TRB_TRACE_POP_EMPTY, 0), (-1)):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head & _trb_##NAME##_buf.mask], sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_##NAME##_buf.head++,\
+    _TRB_STAT_ADD(NAME, pops, 1), _TRB_TRACE(NAME, pop, TRB_TRACE_POP, trb_pow2_size(NAME)), (0)))
+
+/**
+ * \brief   Peek at the front element of a power-of-two buffer without
+ *          removing it
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_pow2_fifo_peek(NAME, VALUE_PTR)\
+    (trb_pow2_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head & _trb_##NAME##_buf.mask], sizeof(_trb_##NAME##_buf.buf[0])),\
     (0)))
 
+/**
+ * \brief   Get a pointer to the i-th oldest element of a power-of-two buffer
+ *          without removing it
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] I         Index from the front, 0 is the oldest element
+ *
+ * \return  Pointer to the element, or NULL if I >= trb_pow2_size(NAME)
+ */
+#define trb_pow2_at(NAME, I)\
+    ((size_t)(I) < trb_pow2_size(NAME) ?\
+    &_trb_##NAME##_buf.buf[(_trb_##NAME##_buf.head + (size_t)(I)) & _trb_##NAME##_buf.mask] : NULL)
+
+/**
+ * \brief   Get the one or two contiguous regions holding the live elements of
+ *          a power-of-two buffer, oldest first, without removing them
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR1_PTR  Receives a pointer to the first region
+ * \param   [out] LEN1_PTR  Receives the number of elements in the first region
+ * \param   [out] PTR2_PTR  Receives a pointer to the second region
+ * \param   [out] LEN2_PTR  Receives the number of elements in the second region
+ *
+ * \return  Number of non-empty regions (0, 1 or 2)
+ */
+#define trb_pow2_spans(NAME, PTR1_PTR, LEN1_PTR, PTR2_PTR, LEN2_PTR)\
+    (*(PTR1_PTR) = &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head & _trb_##NAME##_buf.mask],\
+    *(PTR2_PTR) = &_trb_##NAME##_buf.buf[0],\
+    _trb_spans(_trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head & _trb_##NAME##_buf.mask,\
+               trb_pow2_size(NAME), LEN1_PTR, LEN2_PTR))
+
+/**
+ * \brief   Handle of a ring buffer whose storage and sizes are bound at runtime
+ *
+ *          Unlike TRB_RB_DEFINE, the element storage is supplied by the
+ *          caller (static array, arena, DMA-capable SRAM, hugepages, ...)
+ *          and the handle can be passed around by pointer. The trb_rb_*
+ *          functions mirror the TRB_RB_DEFINE macros: FIFO, deque and LIFO
+ *          ends, bulk, zero-copy reserve/commit and peek_span/release,
+ *          indexed access and spans. Stats counters and trace hooks are
+ *          tied to a NAME and are not kept for handles.
+ */
+typedef struct {
+    size_t         capacity;
+    size_t         head;
+    size_t         tail;
+    size_t         count;
+    size_t         esize;
+    unsigned char *buf;
+} trb_rb_t;
+
+/**
+ * \brief   Bind caller-supplied storage to a runtime ring buffer handle
+ *
+ * \param   [out] rb        Handle to initialize
+ * \param   [in]  storage   At least elem_size * capacity bytes, suitably
+ *                          aligned for the element type
+ * \param   [in]  elem_size Size of one element in bytes
+ * \param   [in]  capacity  Maximum number of elements
+ *
+ * \return  - (0)  Success
+ *          - (-1) Invalid argument
+ */
+static inline int trb_init(trb_rb_t *rb, void *storage, size_t elem_size, size_t capacity)
+{
+    if (rb == NULL || storage == NULL || elem_size == 0 || capacity == 0) {
+        return -1;
+    }
+    rb->capacity = capacity;
+    rb->head = 0;
+    rb->tail = 0;
+    rb->count = 0;
+    rb->esize = elem_size;
+    rb->buf = (unsigned char *)storage;
+    return 0;
+}
+
+/**
+ * \brief   Check if a runtime buffer is empty
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+static inline int trb_rb_is_empty(const trb_rb_t *rb)
+{
+    return rb->count == 0;
+}
+
+/**
+ * \brief   Check if a runtime buffer is full
+ *
+ * \return  - (1): Full
+ *          - (0): Not full
+ */
+static inline int trb_rb_is_full(const trb_rb_t *rb)
+{
+    return rb->count == rb->capacity;
+}
+
+/**
+ * \brief   Get the number of elements currently in a runtime buffer
+ */
+static inline size_t trb_rb_size(const trb_rb_t *rb)
+{
+    return rb->count;
+}
+
+/**
+ * \brief   Get the total capacity of a runtime buffer
+ */
+static inline size_t trb_rb_capacity(const trb_rb_t *rb)
+{
+    return rb->capacity;
+}
+
+/**
+ * \brief   Get the remaining free space in a runtime buffer
+ */
+static inline size_t trb_rb_remaining(const trb_rb_t *rb)
+{
+    return rb->capacity - rb->count;
+}
+
+/**
+ * \brief   Clear a runtime buffer (reset to empty state)
+ */
+static inline void trb_rb_flush(trb_rb_t *rb)
+{
+    rb->head = 0;
+    rb->tail = 0;
+    rb->count = 0;
+}
+
+/**
+ * \brief   Push an element into a runtime buffer
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] value     Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+static inline int trb_rb_fifo_push(trb_rb_t *rb, const void *value)
+{
+    if (trb_rb_is_full(rb)) {
+        return -1;
+    }
+    memcpy(rb->buf + rb->tail * rb->esize, value, rb->esize);
+    if (++rb->tail == rb->capacity) {
+        rb->tail = 0;
+    }
+    rb->count++;
+    return 0;
+}
+
+/**
+ * \brief   Push an element into a runtime buffer, overwriting the oldest
+ *          element if the buffer is full
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] value     Pointer to the element to be pushed
+ */
+static inline void trb_rb_fifo_force_push(trb_rb_t *rb, const void *value)
+{
+    memcpy(rb->buf + rb->tail * rb->esize, value, rb->esize);
+    if (++rb->tail == rb->capacity) {
+        rb->tail = 0;
+    }
+    if (trb_rb_is_full(rb)) {
+        rb->head = rb->tail;
+    } else {
+        rb->count++;
+    }
+}
+
+/**
+ * \brief   Pop an element from a runtime buffer
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] value     Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+static inline int trb_rb_fifo_pop(trb_rb_t *rb, void *value)
+{
+    if (trb_rb_is_empty(rb)) {
+        return -1;
+    }
+    memcpy(value, rb->buf + rb->head * rb->esize, rb->esize);
+    if (++rb->head == rb->capacity) {
+        rb->head = 0;
+    }
+    rb->count--;
+    return 0;
+}
+
+/**
+ * \brief   Peek at the front element of a runtime buffer without removing it
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] value     Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+static inline int trb_rb_fifo_peek(const trb_rb_t *rb, void *value)
+{
+    if (trb_rb_is_empty(rb)) {
+        return -1;
+    }
+    memcpy(value, rb->buf + rb->head * rb->esize, rb->esize);
+    return 0;
+}
+
+/**
+ * \brief   Push up to n elements into a runtime buffer
+ *
+ * \return  Number of elements pushed
+ */
+static inline size_t trb_rb_fifo_push_n(trb_rb_t *rb, const void *src, size_t n)
+{
+    return _trb_push_n(rb->buf, rb->esize, rb->capacity, &rb->tail, &rb->count, src, n, NULL);
+}
+
+/**
+ * \brief   Pop up to n elements from a runtime buffer
+ *
+ * \return  Number of elements popped
+ */
+static inline size_t trb_rb_fifo_pop_n(trb_rb_t *rb, void *dst, size_t n)
+{
+    return _trb_pop_n(rb->buf, rb->esize, rb->capacity, &rb->head, &rb->count, dst, n, NULL);
+}
+
+/**
+ * \brief   Push an element at the front of a runtime buffer, ahead of the
+ *          oldest one
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] value     Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+static inline int trb_rb_push_front(trb_rb_t *rb, const void *value)
+{
+    if (trb_rb_is_full(rb)) {
+        return -1;
+    }
+    rb->head = (rb->head == 0 ? rb->capacity : rb->head) - 1;
+    memcpy(rb->buf + rb->head * rb->esize, value, rb->esize);
+    rb->count++;
+    return 0;
+}
+
+/**
+ * \brief   Pop the element at the back of a runtime buffer (the newest one)
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] value     Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+static inline int trb_rb_pop_back(trb_rb_t *rb, void *value)
+{
+    if (trb_rb_is_empty(rb)) {
+        return -1;
+    }
+    rb->tail = (rb->tail == 0 ? rb->capacity : rb->tail) - 1;
+    memcpy(value, rb->buf + rb->tail * rb->esize, rb->esize);
+    rb->count--;
+    return 0;
+}
+
+/**
+ * \brief   Peek at the back element of a runtime buffer without removing it
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] value     Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+static inline int trb_rb_peek_back(const trb_rb_t *rb, void *value)
+{
+    if (trb_rb_is_empty(rb)) {
+        return -1;
+    }
+    memcpy(value, rb->buf + ((rb->tail == 0 ? rb->capacity : rb->tail) - 1) * rb->esize, rb->esize);
+    return 0;
+}
+
+/**
+ * \brief   Deque and LIFO names for the runtime buffer ends, as for the
+ *          TRB_RB_DEFINE macros
+ */
+#define trb_rb_push_back(RB, VALUE_PTR)   trb_rb_fifo_push(RB, VALUE_PTR)
+#define trb_rb_pop_front(RB, VALUE_PTR)   trb_rb_fifo_pop(RB, VALUE_PTR)
+#define trb_rb_peek_front(RB, VALUE_PTR)  trb_rb_fifo_peek(RB, VALUE_PTR)
+#define trb_rb_lifo_push(RB, VALUE_PTR)   trb_rb_fifo_push(RB, VALUE_PTR)
+#define trb_rb_lifo_pop(RB, VALUE_PTR)    trb_rb_pop_back(RB, VALUE_PTR)
+#define trb_rb_lifo_peek(RB, VALUE_PTR)   trb_rb_peek_back(RB, VALUE_PTR)
+
+/**
+ * \brief   Reserve a contiguous free region at the tail of a runtime buffer
+ *          for in-place writes (see trb_fifo_reserve)
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] ptr       Receives a pointer to the first reserved slot
+ * \param   [in]  max       Maximum number of slots wanted
+ *
+ * \return  Number of contiguous slots reserved, 0 if full
+ */
+static inline size_t trb_rb_fifo_reserve(trb_rb_t *rb, void **ptr, size_t max)
+{
+    *ptr = rb->buf + rb->tail * rb->esize;
+    return _trb_span(rb->capacity, rb->tail, rb->capacity - rb->count, max);
+}
+
+/**
+ * \brief   Publish n slots written in place after trb_rb_fifo_reserve
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] n         Number of slots to commit (at most the reserved count)
+ */
+static inline void trb_rb_fifo_commit(trb_rb_t *rb, size_t n)
+{
+    rb->tail = _trb_wrap(rb->tail + n, rb->capacity);
+    rb->count += n;
+}
+
+/**
+ * \brief   Expose the contiguous run of elements at the head of a runtime
+ *          buffer for in-place reads (see trb_fifo_peek_span)
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] ptr       Receives a pointer to the oldest element
+ *
+ * \return  Number of contiguous elements readable, 0 if empty
+ */
+static inline size_t trb_rb_fifo_peek_span(const trb_rb_t *rb, void **ptr)
+{
+    *ptr = rb->buf + rb->head * rb->esize;
+    return _trb_span(rb->capacity, rb->head, rb->count, rb->count);
+}
+
+/**
+ * \brief   Drop n elements read in place after trb_rb_fifo_peek_span
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] n         Number of elements to release (at most the peeked count)
+ */
+static inline void trb_rb_fifo_release(trb_rb_t *rb, size_t n)
+{
+    rb->head = _trb_wrap(rb->head + n, rb->capacity);
+    rb->count -= n;
+}
+
+/**
+ * \brief   Get a pointer to the i-th oldest element of a runtime buffer
+ *
+ * \param   [in] rb        Buffer handle
+ * \param   [in] i         Index from the front, 0 is the oldest element
+ *
+ * \return  Pointer to the element, or NULL if i >= trb_rb_size(rb)
+ */
+static inline void *trb_rb_at(const trb_rb_t *rb, size_t i)
+{
+    return (i < rb->count) ? rb->buf + _trb_wrap(rb->head + i, rb->capacity) * rb->esize : NULL;
+}
+
+/**
+ * \brief   Get the one or two contiguous regions holding the live elements
+ *          of a runtime buffer, oldest first, without removing them
+ *
+ * \param   [in]  rb        Buffer handle
+ * \param   [out] ptr1      Receives a pointer to the first region
+ * \param   [out] len1      Receives the number of elements in the first region
+ * \param   [out] ptr2      Receives a pointer to the second region
+ * \param   [out] len2      Receives the number of elements in the second region
+ *
+ * \return  Number of non-empty regions (0, 1 or 2)
+ */
+static inline int trb_rb_spans(const trb_rb_t *rb, void **ptr1, size_t *len1, void **ptr2, size_t *len2)
+{
+    *ptr1 = rb->buf + rb->head * rb->esize;
+    *ptr2 = rb->buf;
+    return _trb_spans(rb->capacity, rb->head, rb->count, len1, len2);
+}
+
 #endif /* __TINY_RB_H__ */
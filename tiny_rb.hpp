@@ -0,0 +1,192 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb.hpp
+ *
+ * \brief Lightweight generic ring buffer for C++ (non-thread-safe)
+ *        Elements are constructed in place and moved rather than memcpy'd,
+ *        so any movable type can be stored. Users must add locking
+ *        mechanisms if needed in concurrent contexts.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_HPP__
+#define __TINY_RB_HPP__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tiny_rb {
+
+/**
+ * \brief   Fixed-capacity FIFO ring buffer with in-place element storage
+ *
+ * \tparam  T  Element type (must be move constructible)
+ * \tparam  N  Capacity, a compile-time power of two so wrapping is a mask
+ */
+template <class T, std::size_t N>
+class ring {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "ring capacity must be a power of two");
+
+public:
+    ring() noexcept : head_(0), tail_(0) {}
+
+    ~ring() { clear(); }
+
+    ring(const ring &) = delete;
+    ring &operator=(const ring &) = delete;
+
+    /**
+     * \brief   Move every live element of other into a new ring
+     *
+     *          Elements keep their order, other is left empty.
+     */
+    ring(ring &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : head_(0), tail_(0)
+    {
+        take(other);
+    }
+
+    /**
+     * \brief   Destroy the current elements, then move in those of other
+     *
+     *          Elements keep their order, other is left empty.
+     */
+    ring &operator=(ring &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    /**
+     * \brief   Copy an element into the buffer
+     *
+     * \return  - (true)  Success
+     *          - (false) Buffer full
+     */
+    bool try_push(const T &value) { return emplace(value); }
+
+    /**
+     * \brief   Move an element into the buffer
+     *
+     * \return  - (true)  Success
+     *          - (false) Buffer full, value is left untouched
+     */
+    bool try_push(T &&value) { return emplace(std::move(value)); }
+
+    /**
+     * \brief   Construct an element in place at the back of the buffer
+     *
+     * \return  - (true)  Success
+     *          - (false) Buffer full, nothing is constructed
+     */
+    template <class... Args>
+    bool emplace(Args &&...args)
+    {
+        if (full()) {
+            return false;
+        }
+        ::new (raw(tail_)) T(std::forward<Args>(args)...);
+        ++tail_;
+        return true;
+    }
+
+    /**
+     * \brief   Move the oldest element out of the buffer
+     *
+     * \return  - (true)  Success
+     *          - (false) Buffer empty, out is left untouched
+     */
+    bool try_pop(T &out)
+    {
+        if (empty()) {
+            return false;
+        }
+        T *p = slot(head_);
+        out = std::move(*p);
+        p->~T();
+        ++head_;
+        return true;
+    }
+
+    /**
+     * \brief   Access the oldest element without removing it
+     *
+     *          The buffer must not be empty.
+     */
+    T &front() noexcept { return *slot(head_); }
+    const T &front() const noexcept { return *slot(head_); }
+
+    /**
+     * \brief   Destroy all elements (reset to empty state)
+     */
+    void clear() noexcept
+    {
+        while (!empty()) {
+            slot(head_)->~T();
+            ++head_;
+        }
+        head_ = tail_ = 0;
+    }
+
+    bool empty() const noexcept { return head_ == tail_; }
+    bool full() const noexcept { return size() == N; }
+    std::size_t size() const noexcept { return tail_ - head_; }
+    std::size_t remaining() const noexcept { return N - size(); }
+    static constexpr std::size_t capacity() noexcept { return N; }
+
+private:
+    static constexpr std::size_t mask = N - 1;
+
+    /* Uninitialized bytes of a slot, for placement new */
+    void *raw(std::size_t idx) noexcept
+    {
+        return storage_ + (idx & mask) * sizeof(T);
+    }
+
+    /* Live element in a slot; launder since it was created by placement new */
+    T *slot(std::size_t idx) noexcept
+    {
+#if defined(__cpp_lib_launder)
+        return std::launder(reinterpret_cast<T *>(raw(idx)));
+#else
+        return reinterpret_cast<T *>(raw(idx));
+#endif
+    }
+    const T *slot(std::size_t idx) const noexcept
+    {
+        return const_cast<ring *>(this)->slot(idx);
+    }
+
+    /* Move-construct the elements of other at the back of this ring, then empty other */
+    void take(ring &other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        for (std::size_t i = other.head_; i != other.tail_; ++i) {
+            ::new (raw(tail_)) T(std::move(*other.slot(i)));
+            ++tail_;
+        }
+        other.clear();
+    }
+
+    /* Free-running counters, size is tail_ - head_ */
+    std::size_t head_;
+    std::size_t tail_;
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+};
+
+} /* namespace tiny_rb */
+
+#endif /* __TINY_RB_HPP__ */
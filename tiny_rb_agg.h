@@ -0,0 +1,278 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_agg.h
+ *
+ * \brief Ring buffer with O(1) running aggregates (non-thread-safe, C11)
+ *        Keeps the sum and sum of squares of the live elements up to date
+ *        as elements are pushed, popped or evicted by force push, so window
+ *        mean and variance cost nothing to read. To bound floating-point
+ *        drift, the aggregates are recomputed exactly from the storage every
+ *        max(capacity, TRB_AGG_RESYNC_INTERVAL) removals, so the O(capacity)
+ *        recomputation stays amortized O(1) per removal.
+ *
+ *        TYPE must be an arithmetic type. The buffer has the TRB_RB_DEFINE
+ *        fields so the read-only macros (trb_size, trb_at, trb_spans, ...)
+ *        work on it, but it must be modified through trb_agg_* only.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_AGG_H__
+#define __TINY_RB_AGG_H__
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Minimum number of removals between exact recomputations of the
+ *          aggregates; buffers larger than this resync once per capacity
+ */
+#ifndef TRB_AGG_RESYNC_INTERVAL
+#define TRB_AGG_RESYNC_INTERVAL 4096
+#endif
+
+#define _trb_agg_resync_period(CAPACITY)\
+    ((size_t)(CAPACITY) > (size_t)TRB_AGG_RESYNC_INTERVAL ? (size_t)(CAPACITY) : (size_t)TRB_AGG_RESYNC_INTERVAL)
+
+/**
+ * \brief   Declare a global ring buffer with running aggregates
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (window length)
+ */
+#define TRB_AGG_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t count;\
+        double sum;\
+        double sumsq;\
+        size_t resync_left;\
+        TYPE   buf[CAPACITY];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .head = 0,\
+        .tail = 0,\
+        .count = 0,\
+        .sum = 0.0,\
+        .sumsq = 0.0,\
+        .resync_left = _trb_agg_resync_period(CAPACITY)\
+    }
+
+/**
+ * \brief   Declare a static ring buffer with running aggregates
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (window length)
+ */
+#define TRB_AGG_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_AGG_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global ring buffer with running aggregates
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_AGG_IMPORT(TYPE, NAME)\
+    extern struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t count;\
+        double sum;\
+        double sumsq;\
+        size_t resync_left;\
+        TYPE   buf[];\
+    } _trb_##NAME##_buf
+
+/* Exact recomputation over the live elements, one instance per element type */
+#define _TRB_AGG_RESYNC(T, SUFFIX)\
+    static inline void _trb_agg_resync_##SUFFIX(const void *buf, size_t capacity, size_t head,\
+                                                size_t count, double *sum, double *sumsq)\
+    {\
+        const T *p = (const T *)buf;\
+        double s = 0.0;\
+        double q = 0.0;\
+        size_t i;\
+        \
+        for (i = 0; i < count; i++) {\
+            double v = (double)p[head];\
+            \
+            s += v;\
+            q += v * v;\
+            head = _trb_wrap(head + 1, capacity);\
+        }\
+        *sum = s;\
+        *sumsq = q;\
+    }
+
+_TRB_AGG_RESYNC(char, c)
+_TRB_AGG_RESYNC(signed char, sc)
+_TRB_AGG_RESYNC(unsigned char, uc)
+_TRB_AGG_RESYNC(short, s)
+_TRB_AGG_RESYNC(unsigned short, us)
+_TRB_AGG_RESYNC(int, i)
+_TRB_AGG_RESYNC(unsigned int, ui)
+_TRB_AGG_RESYNC(long, l)
+_TRB_AGG_RESYNC(unsigned long, ul)
+_TRB_AGG_RESYNC(long long, ll)
+_TRB_AGG_RESYNC(unsigned long long, ull)
+_TRB_AGG_RESYNC(float, f)
+_TRB_AGG_RESYNC(double, d)
+
+#define _trb_agg_resync_fn(ELEM)\
+    _Generic((ELEM),\
+        char:               _trb_agg_resync_c,\
+        signed char:        _trb_agg_resync_sc,\
+        unsigned char:      _trb_agg_resync_uc,\
+        short:              _trb_agg_resync_s,\
+        unsigned short:     _trb_agg_resync_us,\
+        int:                _trb_agg_resync_i,\
+        unsigned int:       _trb_agg_resync_ui,\
+        long:               _trb_agg_resync_l,\
+        unsigned long:      _trb_agg_resync_ul,\
+        long long:          _trb_agg_resync_ll,\
+        unsigned long long: _trb_agg_resync_ull,\
+        float:              _trb_agg_resync_f,\
+        double:             _trb_agg_resync_d)
+
+static inline double _trb_agg_variance(double sum, double sumsq, size_t count)
+{
+    double mean;
+    double var;
+
+    if (count == 0) {
+        return 0.0;
+    }
+    mean = sum / (double)count;
+    var = sumsq / (double)count - mean * mean;
+    return (var > 0.0) ? var : 0.0;
+}
+
+/* Add or remove one element value from the aggregates */
+#define _trb_agg_add(NAME, V)\
+    ((void)(_trb_##NAME##_buf.sum += (V), _trb_##NAME##_buf.sumsq += (V) * (V)))
+#define _trb_agg_sub(NAME, V)\
+    ((void)(_trb_##NAME##_buf.sum -= (V), _trb_##NAME##_buf.sumsq -= (V) * (V)))
+
+/* Count a removal; an empty buffer resets exactly, otherwise resync periodically */
+#define _trb_agg_tick(NAME)\
+    (_trb_##NAME##_buf.count == 0 ? (void)(_trb_##NAME##_buf.sum = _trb_##NAME##_buf.sumsq = 0.0) :\
+    (--_trb_##NAME##_buf.resync_left == 0) ? trb_agg_resync(NAME) : (void)0)
+
+/**
+ * \brief   Recompute the aggregates exactly from the buffer contents, O(n)
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_agg_resync(NAME)\
+    ((void)(_trb_agg_resync_fn(_trb_##NAME##_buf.buf[0])(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity,\
+        _trb_##NAME##_buf.head, _trb_##NAME##_buf.count, &_trb_##NAME##_buf.sum, &_trb_##NAME##_buf.sumsq),\
+    _trb_##NAME##_buf.resync_left = _trb_agg_resync_period(_trb_##NAME##_buf.capacity)))
+
+/**
+ * \brief   Get the sum of the live elements
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Sum (double)
+ */
+#define trb_agg_sum(NAME)\
+    (_trb_##NAME##_buf.sum)
+
+/**
+ * \brief   Get the mean of the live elements
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Mean (double), 0 if empty
+ */
+#define trb_agg_mean(NAME)\
+    (_trb_##NAME##_buf.count == 0 ? 0.0 : _trb_##NAME##_buf.sum / (double)_trb_##NAME##_buf.count)
+
+/**
+ * \brief   Get the population variance of the live elements
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Variance (double), 0 if empty
+ */
+#define trb_agg_variance(NAME)\
+    _trb_agg_variance(_trb_##NAME##_buf.sum, _trb_##NAME##_buf.sumsq, _trb_##NAME##_buf.count)
+
+/**
+ * \brief   Clear the buffer and its aggregates
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_agg_flush(NAME)\
+    do {\
+        trb_flush(NAME);\
+        _trb_##NAME##_buf.sum = 0.0;\
+        _trb_##NAME##_buf.sumsq = 0.0;\
+        _trb_##NAME##_buf.resync_left = _trb_agg_resync_period(_trb_##NAME##_buf.capacity);\
+    } while (0)
+
+/**
+ * \brief   Push an element and add it to the aggregates
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_agg_push(NAME, VALUE_PTR)\
+    (trb_is_full(NAME)?(-1):\
+    (memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_agg_add(NAME, (double)_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail]),\
+    _trb_##NAME##_buf.tail = _trb_wrap(_trb_##NAME##_buf.tail + 1, _trb_##NAME##_buf.capacity),\
+    _trb_##NAME##_buf.count++, (0)))
+
+/**
+ * \brief   Push an element, evicting the oldest one if the buffer is full;
+ *          the evicted value is subtracted from the aggregates
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ */
+#define trb_agg_force_push(NAME, VALUE_PTR)\
+    do {\
+        if (trb_is_full(NAME)) {\
+            _trb_agg_sub(NAME, (double)_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head]);\
+            _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity);\
+            _trb_##NAME##_buf.count--;\
+            _trb_agg_tick(NAME);\
+        }\
+        (void)trb_agg_push(NAME, VALUE_PTR);\
+    } while (0)
+
+/**
+ * \brief   Pop the oldest element and remove it from the aggregates
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_agg_pop(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_agg_sub(NAME, (double)_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head]),\
+    _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity),\
+    _trb_##NAME##_buf.count--,\
+    _trb_agg_tick(NAME), (0)))
+
+#endif /* __TINY_RB_AGG_H__ */
@@ -0,0 +1,255 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_bcast.h
+ *
+ * \brief Single-writer, multi-reader broadcast ring buffer (C11 atomics)
+ *        Every element is written once and read by each of a fixed number
+ *        of readers, each advancing its own cursor. The writer either waits
+ *        for the slowest reader (trb_bcast_push) or overwrites the oldest
+ *        elements (trb_bcast_force_push); readers detect being overrun,
+ *        skip to the oldest intact element and count what they lost.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_BCAST_H__
+#define __TINY_RB_BCAST_H__
+
+#include <stdatomic.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Declare a global broadcast ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ * \param   [in] READERS   Number of readers, indexed 0 .. READERS - 1
+ */
+#define TRB_BCAST_DEFINE(TYPE, NAME, CAPACITY, READERS)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        atomic_size_t wseq;\
+        size_t gate;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        size_t readers;\
+        struct {\
+            _Alignas(TRB_CACHELINE_SIZE) atomic_size_t cursor;\
+            size_t dropped;\
+        } reader[READERS];\
+        TYPE   buf[_TRB_POW2_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .tail = 0,\
+        .wseq = 0,\
+        .gate = 0,\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1,\
+        .readers = READERS\
+    }
+
+/**
+ * \brief   Declare a static broadcast ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ * \param   [in] READERS   Number of readers
+ */
+#define TRB_BCAST_DEFINE_STATIC(TYPE, NAME, CAPACITY, READERS)\
+    static TRB_BCAST_DEFINE(TYPE, NAME, CAPACITY, READERS)
+
+/**
+ * \brief   Import a global broadcast ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] READERS   Number of readers (same as in the definition)
+ */
+#define TRB_BCAST_IMPORT(TYPE, NAME, READERS)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        atomic_size_t wseq;\
+        size_t gate;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        size_t readers;\
+        struct {\
+            _Alignas(TRB_CACHELINE_SIZE) atomic_size_t cursor;\
+            size_t dropped;\
+        } reader[READERS];\
+        TYPE   buf[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Check whether the writer may reuse the slot at tail, rescanning
+ *          the reader cursors only when the cached gate says no
+ *
+ * \return  - (1): Slot free
+ *          - (0): The slowest reader still needs it
+ */
+static inline int _trb_bcast_has_room(size_t tail, size_t *gate, size_t capacity,
+                                      const void *readers, size_t stride, size_t n)
+{
+    size_t lag = 0;
+    size_t i;
+
+    if (tail - *gate < capacity) {
+        return 1;
+    }
+    for (i = 0; i < n; i++) {
+        const atomic_size_t *c = (const atomic_size_t *)((const char *)readers + i * stride);
+        size_t d = tail - atomic_load_explicit(c, memory_order_acquire);
+
+        if (d > lag) {
+            lag = d;
+        }
+    }
+    *gate = tail - lag;
+    return lag < capacity;
+}
+
+/**
+ * \brief   Read the element at a reader's cursor, skipping ahead if the
+ *          writer has overrun it
+ *
+ * \return  - (0)  Success
+ *          - (-1) Nothing new for this reader
+ */
+static inline int _trb_bcast_pop(const atomic_size_t *tail, const atomic_size_t *wseq,
+                                 atomic_size_t *cursor,
+                                 size_t *dropped, size_t capacity, size_t mask,
+                                 const unsigned char *buf, size_t esize, void *value)
+{
+    size_t pos = atomic_load_explicit(cursor, memory_order_relaxed);
+
+    for (;;) {
+        size_t t = atomic_load_explicit(tail, memory_order_acquire);
+
+        if (pos == t) {
+            atomic_store_explicit(cursor, pos, memory_order_release);
+            return -1;
+        }
+        if (t - pos > capacity) {
+            *dropped += t - pos - capacity;
+            pos = t - capacity;
+        }
+        memcpy(value, buf + (pos & mask) * esize, esize);
+        /*
+         * Seqlock-style validation: wseq is bumped before the writer touches
+         * a slot, so if it has moved past pos + capacity the copy may be torn
+         */
+        atomic_thread_fence(memory_order_acquire);
+        t = atomic_load_explicit(wseq, memory_order_relaxed);
+        if (t - pos <= capacity) {
+            atomic_store_explicit(cursor, pos + 1, memory_order_release);
+            return 0;
+        }
+        *dropped += t - capacity - pos;
+        pos = t - capacity;
+    }
+}
+
+/**
+ * \brief   Get the total capacity of the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_bcast_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the number of elements a reader has not consumed yet
+ *          (snapshot, may exceed the capacity after force pushes)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] R         Reader index
+ *
+ * \return  Number of pending elements (size_t)
+ */
+#define trb_bcast_pending(NAME, R)\
+    ((size_t)(atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire) -\
+              atomic_load_explicit(&_trb_##NAME##_buf.reader[R].cursor, memory_order_relaxed)))
+
+/**
+ * \brief   Get how many elements a reader lost to force pushes
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] R         Reader index
+ *
+ * \return  Number of dropped elements (size_t)
+ */
+#define trb_bcast_dropped(NAME, R)\
+    (_trb_##NAME##_buf.reader[R].dropped)
+
+/**
+ * \brief   Move a reader to the newest position, discarding its backlog
+ *          (called by that reader, e.g. when it joins late)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] R         Reader index
+ */
+#define trb_bcast_reader_sync(NAME, R)\
+    atomic_store_explicit(&_trb_##NAME##_buf.reader[R].cursor,\
+        atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire), memory_order_release)
+
+/**
+ * \brief   Publish an element to all readers, unless the slowest reader
+ *          still needs the slot (writer only)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full for the slowest reader
+ */
+#define trb_bcast_push(NAME, VALUE_PTR)\
+    (!_trb_bcast_has_room(atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed),\
+                          &_trb_##NAME##_buf.gate, _trb_##NAME##_buf.capacity,\
+                          &_trb_##NAME##_buf.reader[0].cursor, sizeof(_trb_##NAME##_buf.reader[0]),\
+                          _trb_##NAME##_buf.readers)?(-1):\
+    (trb_bcast_force_push(NAME, VALUE_PTR), (0)))
+
+/**
+ * \brief   Publish an element to all readers, overwriting the oldest element
+ *          if a reader lags a full buffer behind (writer only, never blocks)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ */
+#define trb_bcast_force_push(NAME, VALUE_PTR)\
+    (atomic_store_explicit(&_trb_##NAME##_buf.wseq,\
+        atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed) + 1, memory_order_relaxed),\
+    atomic_thread_fence(memory_order_release),\
+    memcpy(&_trb_##NAME##_buf.buf[atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed) & _trb_##NAME##_buf.mask],\
+           VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    atomic_store_explicit(&_trb_##NAME##_buf.tail,\
+        atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed) + 1, memory_order_release))
+
+/**
+ * \brief   Read the next element for one reader (that reader only)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [in]  R         Reader index
+ * \param   [out] VALUE_PTR Pointer where the element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) No new element for this reader
+ */
+#define trb_bcast_pop(NAME, R, VALUE_PTR)\
+    _trb_bcast_pop(&_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.wseq, &_trb_##NAME##_buf.reader[R].cursor,\
+                   &_trb_##NAME##_buf.reader[R].dropped, _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.mask,\
+                   (const unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0]), VALUE_PTR)
+
+#endif /* __TINY_RB_BCAST_H__ */
@@ -0,0 +1,327 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_dma.h
+ *
+ * \brief DMA chunk ring for peripheral streaming (single producer, single
+ *        consumer, C11 atomics)
+ *        The storage is CHUNKS chunks of CHUNK elements, each aligned to
+ *        TRB_DMA_ALIGN, so the chunks can be handed to a DMA controller as
+ *        ping-pong (CHUNKS = 2) or multi-block targets.
+ *
+ *        Receive (ADC, I2S RX, UART RX): the peripheral writes the chunk
+ *        returned by trb_dma_target and the transfer-complete ISR calls
+ *        trb_dma_commit, which only invalidates the cache lines and moves
+ *        tail. The main loop reads with trb_dma_peek_span/trb_dma_release
+ *        or trb_dma_pop.
+ *
+ *        Transmit (DAC, I2S TX): the main loop fills with trb_dma_push, the
+ *        ISR gets up to one chunk of contiguous data from trb_dma_tx_chunk,
+ *        which cleans the cache lines, and calls trb_dma_tx_done once the
+ *        transfer completed.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_DMA_H__
+#define __TINY_RB_DMA_H__
+
+#include <stdatomic.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Alignment of the storage and of every chunk, in bytes
+ *          Set it to the larger of the cache line and the DMA burst size.
+ */
+#ifndef TRB_DMA_ALIGN
+#define TRB_DMA_ALIGN TRB_CACHELINE_SIZE
+#endif
+
+/**
+ * \brief   Cache maintenance hooks, no-ops by default (coherent DMA)
+ *          TRB_DMA_INVALIDATE(ADDR, BYTES) runs before the CPU reads data
+ *          written by DMA; TRB_DMA_CLEAN(ADDR, BYTES) runs before DMA reads
+ *          data written by the CPU. On Cortex-M7, for example:
+ *          #define TRB_DMA_INVALIDATE(A, N) SCB_InvalidateDCache_by_Addr((void *)(A), (int32_t)(N))
+ *          #define TRB_DMA_CLEAN(A, N)      SCB_CleanDCache_by_Addr((void *)(A), (int32_t)(N))
+ */
+#ifndef TRB_DMA_INVALIDATE
+#define TRB_DMA_INVALIDATE(ADDR, BYTES) ((void)(ADDR), (void)(BYTES))
+#endif
+#ifndef TRB_DMA_CLEAN
+#define TRB_DMA_CLEAN(ADDR, BYTES) ((void)(ADDR), (void)(BYTES))
+#endif
+
+/*
+ * Compile-time check that a chunk fills whole TRB_DMA_ALIGN units
+ * An illegal value produces a negative array size
+ */
+#define _TRB_DMA_CHUNK_CHECK(TYPE, CHUNK)\
+    ((((CHUNK) > 0) && ((sizeof(TYPE) * (CHUNK)) % TRB_DMA_ALIGN == 0)) ? (CHUNK) : -1)
+
+/**
+ * \brief   Declare a global DMA chunk ring
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CHUNK     Elements per chunk (power of two, sizeof(TYPE) * CHUNK
+ *                         a multiple of TRB_DMA_ALIGN)
+ * \param   [in] CHUNKS    Number of chunks (power of two, 2 for ping-pong)
+ */
+#define TRB_DMA_DEFINE(TYPE, NAME, CHUNK, CHUNKS)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        size_t overruns;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        size_t chunk;\
+        _Alignas(TRB_DMA_ALIGN) TYPE buf[_TRB_POW2_CHECK(_TRB_DMA_CHUNK_CHECK(TYPE, CHUNK) * (CHUNKS))];\
+    } _trb_##NAME##_buf = {\
+        .head = 0,\
+        .tail = 0,\
+        .capacity = (CHUNK) * (CHUNKS),\
+        .mask = (CHUNK) * (CHUNKS) - 1,\
+        .chunk = CHUNK\
+    }
+
+/**
+ * \brief   Declare a static DMA chunk ring
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CHUNK     Elements per chunk
+ * \param   [in] CHUNKS    Number of chunks
+ */
+#define TRB_DMA_DEFINE_STATIC(TYPE, NAME, CHUNK, CHUNKS)\
+    static TRB_DMA_DEFINE(TYPE, NAME, CHUNK, CHUNKS)
+
+/**
+ * \brief   Import a global DMA chunk ring
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_DMA_IMPORT(TYPE, NAME)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        size_t overruns;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        size_t chunk;\
+        _Alignas(TRB_DMA_ALIGN) TYPE buf[];\
+    } _trb_##NAME##_buf
+
+/* Producer side: advance tail by n elements written in place */
+static inline int _trb_dma_commit(atomic_size_t *head, atomic_size_t *tail, size_t *overruns,
+                                  size_t capacity, size_t mask, unsigned char *buf,
+                                  size_t esize, size_t n)
+{
+    size_t t = atomic_load_explicit(tail, memory_order_relaxed);
+
+    /* A DMA write into one target address cannot wrap, so neither can its invalidate */
+    if (n > capacity - (t & mask)) {
+        return -1;
+    }
+    if (n > capacity - (t - atomic_load_explicit(head, memory_order_acquire))) {
+        (*overruns)++;
+        return -1;
+    }
+    TRB_DMA_INVALIDATE(buf + (t & mask) * esize, n * esize);
+    atomic_store_explicit(tail, t + n, memory_order_release);
+    return 0;
+}
+
+/* Consumer side: contiguous elements from head, up to max */
+static inline size_t _trb_dma_span(atomic_size_t *head, atomic_size_t *tail, size_t capacity,
+                                   size_t mask, size_t max)
+{
+    size_t h = atomic_load_explicit(head, memory_order_relaxed);
+
+    return _trb_span(capacity, h & mask, atomic_load_explicit(tail, memory_order_acquire) - h, max);
+}
+
+/* Transmit consumer: up to one chunk from head, cleaned for the DMA read */
+static inline size_t _trb_dma_tx_span(atomic_size_t *head, atomic_size_t *tail, size_t capacity,
+                                      size_t mask, unsigned char *buf, size_t esize, size_t chunk)
+{
+    size_t n = _trb_dma_span(head, tail, capacity, mask, chunk);
+
+    TRB_DMA_CLEAN(buf + (atomic_load_explicit(head, memory_order_relaxed) & mask) * esize, n * esize);
+    return n;
+}
+
+/* Oldest element, read by the consumer */
+#define _trb_dma_front(NAME)\
+    (&_trb_##NAME##_buf.buf[atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_relaxed) &\
+                            _trb_##NAME##_buf.mask])
+
+/* Arguments shared by the helpers above */
+#define _trb_dma_args(NAME)\
+    &_trb_##NAME##_buf.head, &_trb_##NAME##_buf.tail
+
+#define _trb_dma_layout(NAME)\
+    _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.mask,\
+    (unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0])
+
+/**
+ * \brief   Get the number of elements currently in the buffer (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_dma_size(NAME)\
+    ((size_t)(atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire) -\
+              atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_acquire)))
+
+/**
+ * \brief   Get the total capacity of the buffer (CHUNK * CHUNKS)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_dma_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the number of commits rejected because the buffer was full
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Overrun count (size_t)
+ */
+#define trb_dma_overruns(NAME)\
+    (_trb_##NAME##_buf.overruns)
+
+/**
+ * \brief   Get a pointer to chunk I, e.g. to program circular DMA once
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] I         Chunk index (0 to CHUNKS - 1)
+ *
+ * \return  Pointer to the first element of the chunk
+ */
+#define trb_dma_chunk(NAME, I)\
+    (&_trb_##NAME##_buf.buf[(size_t)(I) * _trb_##NAME##_buf.chunk])
+
+/**
+ * \brief   Get the next chunk the peripheral may write (receive producer)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Pointer to the chunk at tail, NULL if the consumer has not freed
+ *          a full chunk yet
+ */
+#define trb_dma_target(NAME)\
+    ((_trb_##NAME##_buf.capacity - trb_dma_size(NAME) < _trb_##NAME##_buf.chunk) ? NULL :\
+    &_trb_##NAME##_buf.buf[atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed) &\
+                           _trb_##NAME##_buf.mask])
+
+/**
+ * \brief   Publish LEN elements written by DMA at tail (receive producer)
+ *
+ *          Keep LEN a multiple of CHUNK so that every target stays aligned;
+ *          a shorter LEN (e.g. on a UART idle-line event) must be followed
+ *          by the rest of the chunk before the next chunk is targeted.
+ *          LEN must not run past the end of the storage: a commit starting
+ *          at the last chunk covers at most that chunk.
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] LEN       Number of elements written
+ *
+ * \return  - (0)  Success
+ *          - (-1) LEN runs past the end of the storage, or not enough room
+ *                 (the overrun counter is incremented); nothing is published
+ */
+#define trb_dma_commit(NAME, LEN)\
+    _trb_dma_commit(_trb_dma_args(NAME), &_trb_##NAME##_buf.overruns, _trb_dma_layout(NAME), (size_t)(LEN))
+
+/**
+ * \brief   Get the oldest elements in place (receive consumer)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR_PTR   Receives a pointer to the oldest element
+ *
+ * \return  Number of contiguous elements readable (size_t), 0 if empty
+ */
+#define trb_dma_peek_span(NAME, PTR_PTR)\
+    (*(PTR_PTR) = _trb_dma_front(NAME),\
+    _trb_dma_span(_trb_dma_args(NAME), _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.mask, (size_t)-1))
+
+/**
+ * \brief   Free N elements read in place (receive consumer)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] N         Number of elements to release (at most the peeked count)
+ */
+#define trb_dma_release(NAME, N)\
+    ((void)atomic_store_explicit(&_trb_##NAME##_buf.head,\
+        atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_relaxed) + (size_t)(N),\
+        memory_order_release))
+
+/**
+ * \brief   Pop one element (receive consumer)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_dma_pop(NAME, VALUE_PTR)\
+    ((atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire) ==\
+      atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_relaxed))?(-1):\
+    (memcpy(VALUE_PTR, _trb_dma_front(NAME), sizeof(_trb_##NAME##_buf.buf[0])),\
+    trb_dma_release(NAME, 1), (0)))
+
+/**
+ * \brief   Push one element for transmission (transmit producer)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_dma_push(NAME, VALUE_PTR)\
+    ((trb_dma_size(NAME) == _trb_##NAME##_buf.capacity)?(-1):\
+    (memcpy(&_trb_##NAME##_buf.buf[atomic_load_explicit(&_trb_##NAME##_buf.tail,\
+            memory_order_relaxed) & _trb_##NAME##_buf.mask], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    atomic_store_explicit(&_trb_##NAME##_buf.tail,\
+        atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed) + 1, memory_order_release),\
+    (0)))
+
+/**
+ * \brief   Get up to one chunk of contiguous data for a DMA transfer and
+ *          clean it from the cache (transmit consumer)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR_PTR   Receives the DMA source address
+ *
+ * \return  Number of elements to transfer (size_t), 0 if empty
+ */
+#define trb_dma_tx_chunk(NAME, PTR_PTR)\
+    (*(PTR_PTR) = _trb_dma_front(NAME),\
+    _trb_dma_tx_span(_trb_dma_args(NAME), _trb_dma_layout(NAME), _trb_##NAME##_buf.chunk))
+
+/**
+ * \brief   Free N elements once their DMA transfer completed (transmit consumer)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] N         Number of elements transferred
+ */
+#define trb_dma_tx_done(NAME, N)\
+    trb_dma_release(NAME, N)
+
+#endif /* __TINY_RB_DMA_H__ */
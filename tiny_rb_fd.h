@@ -0,0 +1,231 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_fd.h
+ *
+ * \brief Move bytes between file descriptors and a byte ring buffer
+ *        trb_fill_from_fd and trb_drain_to_fd issue a single readv/writev
+ *        whose two iovecs point straight at the free (or used) region of a
+ *        TRB_RB_DEFINE(uint8_t, ...) buffer on both sides of the wrap, so
+ *        there is no bounce buffer and one system call per direction.
+ *
+ *        Define TRB_FD_URING and link liburing to also get io_uring
+ *        submission forms (prep + complete).
+ *
+ *        Needs readv()/writev() from <sys/uio.h> (POSIX); with strict
+ *        -std=c99/c11 define _POSIX_C_SOURCE >= 200112L before any include.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_FD_H__
+#define __TINY_RB_FD_H__
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#ifdef TRB_FD_URING
+#include <liburing.h>
+#endif
+
+#include "tiny_rb.h"
+
+/*
+ * Compile-time check that the buffer holds single bytes (a partial read
+ * of a larger element could not be undone); evaluates to 0
+ * An illegal buffer produces a negative array size
+ */
+#define _TRB_FD_BYTE_CHECK(NAME)\
+    (0 * sizeof(char[(sizeof(_trb_##NAME##_buf.buf[0]) == 1) ? 1 : -1]))
+
+/**
+ * \brief   Describe avail bytes starting at idx as up to two iovecs
+ *
+ * \return  Number of iovecs used (0, 1 or 2)
+ */
+static inline int _trb_fd_iov(unsigned char *buf, size_t capacity, size_t idx,
+                              size_t avail, struct iovec iov[2])
+{
+    size_t first = _trb_span(capacity, idx, avail, avail);
+
+    iov[0].iov_base = buf + idx;
+    iov[0].iov_len = first;
+    iov[1].iov_base = buf;
+    iov[1].iov_len = avail - first;
+    return (first != 0) + (avail - first != 0);
+}
+
+/**
+ * \brief   Account n bytes transferred: advance idx, adjust count and stats
+ */
+static inline void _trb_fd_advance(size_t capacity, size_t *idx, size_t *count,
+                                   size_t n, int fill, trb_stats_t *stats)
+{
+    *idx += n;
+    if (*idx >= capacity) {
+        *idx -= capacity;
+    }
+    if (fill) {
+        *count += n;
+    } else {
+        *count -= n;
+    }
+    if (stats != NULL) {
+        if (fill) {
+            stats->pushes += n;
+            if (*count > stats->peak) {
+                stats->peak = *count;
+            }
+        } else {
+            stats->pops += n;
+        }
+    }
+}
+
+static inline ssize_t _trb_fd_fill(int fd, unsigned char *buf, size_t capacity,
+                                   size_t *tail, size_t *count, trb_stats_t *stats)
+{
+    struct iovec iov[2];
+    int cnt = _trb_fd_iov(buf, capacity, *tail, capacity - *count, iov);
+    ssize_t n;
+
+    if (cnt == 0) {
+        return -2;
+    }
+    n = readv(fd, iov, cnt);
+    if (n > 0) {
+        _trb_fd_advance(capacity, tail, count, (size_t)n, 1, stats);
+    }
+    return n;
+}
+
+static inline ssize_t _trb_fd_drain(int fd, unsigned char *buf, size_t capacity,
+                                    size_t *head, size_t *count, trb_stats_t *stats)
+{
+    struct iovec iov[2];
+    int cnt = _trb_fd_iov(buf, capacity, *head, *count, iov);
+    ssize_t n;
+
+    if (cnt == 0) {
+        return -2;
+    }
+    n = writev(fd, iov, cnt);
+    if (n > 0) {
+        _trb_fd_advance(capacity, head, count, (size_t)n, 0, stats);
+    }
+    return n;
+}
+
+/**
+ * \brief   Read from FD straight into the free space of a byte buffer
+ *
+ * \param   [in] NAME      Buffer name (TYPE of size 1, e.g. uint8_t)
+ * \param   [in] FD        File descriptor to read from
+ *
+ * \return  - (>0) Bytes read and pushed
+ *          - (0)  End of file
+ *          - (-1) readv failed, see errno (EAGAIN on a non-blocking FD)
+ *          - (-2) Buffer full, nothing read
+ */
+#define trb_fill_from_fd(NAME, FD)\
+    _trb_fd_fill(FD, (unsigned char *)_trb_##NAME##_buf.buf,\
+                 _trb_##NAME##_buf.capacity + _TRB_FD_BYTE_CHECK(NAME),\
+                 &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.count, _TRB_STATS_PTR(NAME))
+
+/**
+ * \brief   Write the buffered bytes straight from the buffer to FD
+ *
+ * \param   [in] NAME      Buffer name (TYPE of size 1, e.g. uint8_t)
+ * \param   [in] FD        File descriptor to write to
+ *
+ * \return  - (>0) Bytes written and popped
+ *          - (0)  Nothing written
+ *          - (-1) writev failed, see errno (EAGAIN on a non-blocking FD)
+ *          - (-2) Buffer empty, nothing written
+ */
+#define trb_drain_to_fd(NAME, FD)\
+    _trb_fd_drain(FD, (unsigned char *)_trb_##NAME##_buf.buf,\
+                  _trb_##NAME##_buf.capacity + _TRB_FD_BYTE_CHECK(NAME),\
+                  &_trb_##NAME##_buf.head, &_trb_##NAME##_buf.count, _TRB_STATS_PTR(NAME))
+
+#ifdef TRB_FD_URING
+
+static inline int _trb_fd_prep_uring(struct io_uring_sqe *sqe, int fd, struct iovec *iov, int cnt, int fill)
+{
+    if (cnt == 0) {
+        return 0;
+    }
+    if (fill) {
+        io_uring_prep_readv(sqe, fd, iov, (unsigned)cnt, (__u64)-1);
+    } else {
+        io_uring_prep_writev(sqe, fd, iov, (unsigned)cnt, (__u64)-1);
+    }
+    return cnt;
+}
+
+/**
+ * \brief   Prepare an io_uring readv into the free space of a byte buffer
+ *
+ *          IOV must stay valid until the completion is reaped, and the
+ *          buffer must not be pushed to until trb_fill_complete is called.
+ *
+ * \param   [in]  NAME      Buffer name (TYPE of size 1)
+ * \param   [in]  SQE       struct io_uring_sqe * from io_uring_get_sqe
+ * \param   [in]  FD        File descriptor to read from
+ * \param   [out] IOV       struct iovec[2] backing the request
+ *
+ * \return  Number of iovecs prepared, 0 if the buffer is full (SQE untouched)
+ */
+#define trb_fill_prep_uring(NAME, SQE, FD, IOV)\
+    _trb_fd_prep_uring(SQE, FD, IOV, _trb_fd_iov((unsigned char *)_trb_##NAME##_buf.buf,\
+                       _trb_##NAME##_buf.capacity + _TRB_FD_BYTE_CHECK(NAME), _trb_##NAME##_buf.tail,\
+                       _trb_##NAME##_buf.capacity - _trb_##NAME##_buf.count, IOV), 1)
+
+/**
+ * \brief   Prepare an io_uring writev of the buffered bytes
+ *
+ *          IOV must stay valid until the completion is reaped, and the
+ *          buffer must not be popped from until trb_drain_complete is called.
+ *
+ * \param   [in]  NAME      Buffer name (TYPE of size 1)
+ * \param   [in]  SQE       struct io_uring_sqe * from io_uring_get_sqe
+ * \param   [in]  FD        File descriptor to write to
+ * \param   [out] IOV       struct iovec[2] backing the request
+ *
+ * \return  Number of iovecs prepared, 0 if the buffer is empty (SQE untouched)
+ */
+#define trb_drain_prep_uring(NAME, SQE, FD, IOV)\
+    _trb_fd_prep_uring(SQE, FD, IOV, _trb_fd_iov((unsigned char *)_trb_##NAME##_buf.buf,\
+                       _trb_##NAME##_buf.capacity + _TRB_FD_BYTE_CHECK(NAME), _trb_##NAME##_buf.head,\
+                       _trb_##NAME##_buf.count, IOV), 0)
+
+/**
+ * \brief   Commit the bytes read by a completed trb_fill_prep_uring request
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] RES       cqe->res of the completion (ignored if <= 0)
+ */
+#define trb_fill_complete(NAME, RES)\
+    ((RES) > 0 ? _trb_fd_advance(_trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.tail,\
+                                 &_trb_##NAME##_buf.count, (size_t)(RES), 1, _TRB_STATS_PTR(NAME)) : (void)0)
+
+/**
+ * \brief   Release the bytes written by a completed trb_drain_prep_uring request
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] RES       cqe->res of the completion (ignored if <= 0)
+ */
+#define trb_drain_complete(NAME, RES)\
+    ((RES) > 0 ? _trb_fd_advance(_trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.head,\
+                                 &_trb_##NAME##_buf.count, (size_t)(RES), 0, _TRB_STATS_PTR(NAME)) : (void)0)
+
+#endif /* TRB_FD_URING */
+
+#endif /* __TINY_RB_FD_H__ */
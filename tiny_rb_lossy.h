@@ -0,0 +1,231 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_lossy.h
+ *
+ * \brief Lossy single-producer, single-consumer ring buffer (C11 atomics)
+ *        "Latest N always": the producer never blocks and overwrites the
+ *        oldest slot when the consumer falls behind, so pushing is
+ *        wait-free. Every slot carries a version (seqlock) that is odd
+ *        while the slot is being written and encodes the position it
+ *        holds once complete. The consumer validates the version around
+ *        its copy, skips overwritten or torn slots and counts them as
+ *        dropped. Unlike trb_fifo_force_push, head is only ever written
+ *        by the consumer, so producer and consumer may run concurrently.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_LOSSY_H__
+#define __TINY_RB_LOSSY_H__
+
+#include <stdatomic.h>
+
+#include "tiny_rb.h"
+
+/*
+ * Slot versions, zero-initialized buffers are valid (no slot complete):
+ *   - being written for position pos: ver == 2 * pos + 1
+ *   - holding position pos:           ver == 2 * pos + 2
+ */
+
+/**
+ * \brief   Declare a global lossy SPSC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_LOSSY_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        size_t dropped;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        struct {\
+            atomic_size_t ver;\
+            TYPE          data;\
+        } slot[_TRB_POW2_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .head = 0,\
+        .dropped = 0,\
+        .tail = 0,\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1\
+    }
+
+/**
+ * \brief   Declare a static lossy SPSC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_LOSSY_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_LOSSY_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global lossy SPSC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_LOSSY_IMPORT(TYPE, NAME)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        size_t dropped;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        struct {\
+            atomic_size_t ver;\
+            TYPE          data;\
+        } slot[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Write the slot at tail unconditionally (producer only)
+ */
+static inline void _trb_lossy_push(atomic_size_t *tail, size_t mask,
+                                   char *slots, size_t stride, size_t data_off,
+                                   const void *value, size_t esize)
+{
+    size_t pos = atomic_load_explicit(tail, memory_order_relaxed);
+    char *slot = slots + (pos & mask) * stride;
+    atomic_size_t *ver = (atomic_size_t *)slot;
+
+    atomic_store_explicit(ver, 2 * pos + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(slot + data_off, value, esize);
+    atomic_store_explicit(ver, 2 * pos + 2, memory_order_release);
+    atomic_store_explicit(tail, pos + 1, memory_order_release);
+}
+
+/**
+ * \brief   Copy out the oldest intact element (consumer only)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Nothing new
+ */
+static inline int _trb_lossy_pop(atomic_size_t *head, const atomic_size_t *tail,
+                                 size_t *dropped, size_t capacity, size_t mask,
+                                 const char *slots, size_t stride, size_t data_off,
+                                 void *value, size_t esize)
+{
+    size_t pos = atomic_load_explicit(head, memory_order_relaxed);
+
+    for (;;) {
+        size_t t = atomic_load_explicit(tail, memory_order_acquire);
+        const char *slot;
+        const atomic_size_t *ver;
+        size_t v1;
+
+        if (pos == t) {
+            atomic_store_explicit(head, pos, memory_order_release);
+            return -1;
+        }
+        if (t - pos > capacity) {
+            *dropped += t - pos - capacity;
+            pos = t - capacity;
+        }
+        slot = slots + (pos & mask) * stride;
+        ver = (const atomic_size_t *)slot;
+        v1 = atomic_load_explicit(ver, memory_order_acquire);
+        if (v1 == 2 * pos + 2) {
+            memcpy(value, slot + data_off, esize);
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(ver, memory_order_relaxed) == v1) {
+                atomic_store_explicit(head, pos + 1, memory_order_release);
+                return 0;
+            }
+        }
+        /*
+         * The slot now belongs to a later lap: the writer is at least a full
+         * lap ahead, so skip this slot and re-read tail
+         */
+        (*dropped)++;
+        pos++;
+    }
+}
+
+/* Unread count, clamped while the producer is a lap or more ahead */
+static inline size_t _trb_lossy_size(const atomic_size_t *head, const atomic_size_t *tail, size_t capacity)
+{
+    size_t t = atomic_load_explicit(tail, memory_order_acquire);
+    size_t n = t - atomic_load_explicit(head, memory_order_acquire);
+
+    return (n > capacity) ? capacity : n;
+}
+
+/* Slot layout arguments shared by push and pop */
+#define _trb_lossy_slots(NAME)\
+    (char *)_trb_##NAME##_buf.slot, sizeof(_trb_##NAME##_buf.slot[0]),\
+    (size_t)((char *)&_trb_##NAME##_buf.slot[0].data - (char *)&_trb_##NAME##_buf.slot[0])
+
+/**
+ * \brief   Get the number of unread elements still held (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements, at most the capacity (size_t)
+ */
+#define trb_lossy_size(NAME)\
+    _trb_lossy_size(&_trb_##NAME##_buf.head, &_trb_##NAME##_buf.tail, _trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the total capacity of the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_lossy_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the number of elements overwritten before the consumer read
+ *          them (consumer only)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Drop count (size_t)
+ */
+#define trb_lossy_dropped(NAME)\
+    (_trb_##NAME##_buf.dropped)
+
+/**
+ * \brief   Push an element, overwriting the oldest one when full (producer
+ *          only, wait-free)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ */
+#define trb_lossy_push(NAME, VALUE_PTR)\
+    _trb_lossy_push(&_trb_##NAME##_buf.tail, _trb_##NAME##_buf.mask, _trb_lossy_slots(NAME),\
+                    VALUE_PTR, sizeof(_trb_##NAME##_buf.slot[0].data))
+
+/**
+ * \brief   Pop the oldest element that has not been overwritten (consumer only)
+ *
+ *          *VALUE_PTR may be clobbered even when -1 is returned.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_lossy_pop(NAME, VALUE_PTR)\
+    _trb_lossy_pop(&_trb_##NAME##_buf.head, &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.dropped,\
+                   _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.mask, _trb_lossy_slots(NAME),\
+                   VALUE_PTR, sizeof(_trb_##NAME##_buf.slot[0].data))
+
+#endif /* __TINY_RB_LOSSY_H__ */
@@ -0,0 +1,255 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_mono.h
+ *
+ * \brief Ring buffer with sliding-window min/max (non-thread-safe, C11)
+ *        Next to the data ring, two monotonic deques of slot indices are
+ *        kept in static storage of the same capacity: one with strictly
+ *        decreasing values (front is the window max) and one with strictly
+ *        increasing values (front is the window min). Push, pop and force
+ *        push keep them in lockstep with the data ring, giving amortized O(1)
+ *        updates and O(1) window min/max.
+ *
+ *        TYPE must be an arithmetic type. The buffer has the TRB_RB_DEFINE
+ *        fields so the read-only macros (trb_size, trb_at, trb_spans, ...)
+ *        work on it, but it must be modified through trb_mono_* only.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_MONO_H__
+#define __TINY_RB_MONO_H__
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Declare a global ring buffer with sliding-window min/max
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (window length)
+ */
+#define TRB_MONO_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t count;\
+        size_t min_head;\
+        size_t min_count;\
+        size_t max_head;\
+        size_t max_count;\
+        size_t minq[CAPACITY];\
+        size_t maxq[CAPACITY];\
+        TYPE   buf[CAPACITY];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .head = 0,\
+        .tail = 0,\
+        .count = 0\
+    }
+
+/**
+ * \brief   Declare a static ring buffer with sliding-window min/max
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (window length)
+ */
+#define TRB_MONO_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_MONO_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global ring buffer with sliding-window min/max
+ *
+ * \param   [in] TYPE      Arithmetic data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Capacity used in the definition
+ */
+#define TRB_MONO_IMPORT(TYPE, NAME, CAPACITY)\
+    extern struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t count;\
+        size_t min_head;\
+        size_t min_count;\
+        size_t max_head;\
+        size_t max_count;\
+        size_t minq[CAPACITY];\
+        size_t maxq[CAPACITY];\
+        TYPE   buf[CAPACITY];\
+    } _trb_##NAME##_buf
+
+/*
+ * Append slot to a monotonic deque after dropping the candidates it
+ * dominates (values <= it for the max deque, >= it for the min deque)
+ */
+#define _TRB_MONO_ADMIT(T, SUFFIX)\
+    static inline void _trb_mono_admit_##SUFFIX(const void *buf, size_t *q, size_t capacity,\
+                                                size_t qhead, size_t *qcount, size_t slot, int is_max)\
+    {\
+        const T *p = (const T *)buf;\
+        T v = p[slot];\
+        \
+        while (*qcount > 0) {\
+            T back = p[q[_trb_wrap(qhead + *qcount - 1, capacity)]];\
+            \
+            if (is_max ? (back > v) : (back < v)) {\
+                break;\
+            }\
+            (*qcount)--;\
+        }\
+        q[_trb_wrap(qhead + *qcount, capacity)] = slot;\
+        (*qcount)++;\
+    }
+
+_TRB_MONO_ADMIT(char, c)
+_TRB_MONO_ADMIT(signed char, sc)
+_TRB_MONO_ADMIT(unsigned char, uc)
+_TRB_MONO_ADMIT(short, s)
+_TRB_MONO_ADMIT(unsigned short, us)
+_TRB_MONO_ADMIT(int, i)
+_TRB_MONO_ADMIT(unsigned int, ui)
+_TRB_MONO_ADMIT(long, l)
+_TRB_MONO_ADMIT(unsigned long, ul)
+_TRB_MONO_ADMIT(long long, ll)
+_TRB_MONO_ADMIT(unsigned long long, ull)
+_TRB_MONO_ADMIT(float, f)
+_TRB_MONO_ADMIT(double, d)
+
+#define _trb_mono_admit_fn(ELEM)\
+    _Generic((ELEM),\
+        char:               _trb_mono_admit_c,\
+        signed char:        _trb_mono_admit_sc,\
+        unsigned char:      _trb_mono_admit_uc,\
+        short:              _trb_mono_admit_s,\
+        unsigned short:     _trb_mono_admit_us,\
+        int:                _trb_mono_admit_i,\
+        unsigned int:       _trb_mono_admit_ui,\
+        long:               _trb_mono_admit_l,\
+        unsigned long:      _trb_mono_admit_ul,\
+        long long:          _trb_mono_admit_ll,\
+        unsigned long long: _trb_mono_admit_ull,\
+        float:              _trb_mono_admit_f,\
+        double:             _trb_mono_admit_d)
+
+/* Drop the deque front if it refers to the slot leaving the window */
+static inline void _trb_mono_evict(const size_t *q, size_t capacity,
+                                   size_t *qhead, size_t *qcount, size_t slot)
+{
+    if (*qcount > 0 && q[*qhead] == slot) {
+        *qhead = _trb_wrap(*qhead + 1, capacity);
+        (*qcount)--;
+    }
+}
+
+/* Remove the oldest element from the data ring and both deques */
+#define _trb_mono_drop_oldest(NAME)\
+    (_trb_mono_evict(_trb_##NAME##_buf.minq, _trb_##NAME##_buf.capacity,\
+                     &_trb_##NAME##_buf.min_head, &_trb_##NAME##_buf.min_count, _trb_##NAME##_buf.head),\
+    _trb_mono_evict(_trb_##NAME##_buf.maxq, _trb_##NAME##_buf.capacity,\
+                    &_trb_##NAME##_buf.max_head, &_trb_##NAME##_buf.max_count, _trb_##NAME##_buf.head),\
+    _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity),\
+    _trb_##NAME##_buf.count--)
+
+/**
+ * \brief   Push an element and update the window min/max
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_mono_push(NAME, VALUE_PTR)\
+    (trb_is_full(NAME)?(-1):\
+    (memcpy(&_trb_##NAME##_buf.buf[_trb_##NAME##_buf.tail], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_mono_admit_fn(_trb_##NAME##_buf.buf[0])(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.maxq,\
+        _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.max_head, &_trb_##NAME##_buf.max_count,\
+        _trb_##NAME##_buf.tail, 1),\
+    _trb_mono_admit_fn(_trb_##NAME##_buf.buf[0])(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.minq,\
+        _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.min_head, &_trb_##NAME##_buf.min_count,\
+        _trb_##NAME##_buf.tail, 0),\
+    _trb_##NAME##_buf.tail = _trb_wrap(_trb_##NAME##_buf.tail + 1, _trb_##NAME##_buf.capacity),\
+    _trb_##NAME##_buf.count++, (0)))
+
+/**
+ * \brief   Push an element, evicting the oldest one if the buffer is full
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ */
+#define trb_mono_force_push(NAME, VALUE_PTR)\
+    do {\
+        if (trb_is_full(NAME)) {\
+            _trb_mono_drop_oldest(NAME);\
+        }\
+        (void)trb_mono_push(NAME, VALUE_PTR);\
+    } while (0)
+
+/**
+ * \brief   Pop the oldest element
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_mono_pop(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_mono_drop_oldest(NAME), (0)))
+
+/**
+ * \brief   Get the smallest element in the window
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the minimum will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_mono_min(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.minq[_trb_##NAME##_buf.min_head]],\
+            sizeof(_trb_##NAME##_buf.buf[0])), (0)))
+
+/**
+ * \brief   Get the largest element in the window
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the maximum will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_mono_max(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.maxq[_trb_##NAME##_buf.max_head]],\
+            sizeof(_trb_##NAME##_buf.buf[0])), (0)))
+
+/**
+ * \brief   Clear the buffer and its min/max deques
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_mono_flush(NAME)\
+    do {\
+        trb_flush(NAME);\
+        _trb_##NAME##_buf.min_head = 0;\
+        _trb_##NAME##_buf.min_count = 0;\
+        _trb_##NAME##_buf.max_head = 0;\
+        _trb_##NAME##_buf.max_count = 0;\
+    } while (0)
+
+#endif /* __TINY_RB_MONO_H__ */
@@ -0,0 +1,233 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_mpmc.h
+ *
+ * \brief Lock-free multi-producer/multi-consumer bounded ring buffer
+ *        (C11 atomics). Every slot carries a sequence number so producers
+ *        and consumers only contend on their own index, in the style of
+ *        Dmitry Vyukov's bounded MPMC queue.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_MPMC_H__
+#define __TINY_RB_MPMC_H__
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/*
+ * Slot sequence numbers are stored relative to the slot index, so a
+ * zero-initialized buffer is already valid and no init call is needed:
+ *   - slot free for the lap of position pos:  seq == (pos & ~mask)
+ *   - slot filled at position pos:            seq == (pos & ~mask) + 1
+ */
+
+/**
+ * \brief   Declare a global MPMC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two, >= 2)
+ */
+#define TRB_MPMC_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        struct {\
+            atomic_size_t seq;\
+            TYPE          data;\
+        } slot[_TRB_POW2_CHECK((CAPACITY) > 1 ? (CAPACITY) : -1)];\
+    } _trb_##NAME##_buf = {\
+        .head = 0,\
+        .tail = 0,\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1\
+    }
+
+/**
+ * \brief   Declare a static MPMC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two, >= 2)
+ */
+#define TRB_MPMC_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_MPMC_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global MPMC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_MPMC_IMPORT(TYPE, NAME)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        struct {\
+            atomic_size_t seq;\
+            TYPE          data;\
+        } slot[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Claim the slot at tail, copy the element in and publish it
+ *
+ * \param   [in,out] tail      Enqueue position shared by all producers
+ * \param   [in]     mask      capacity - 1
+ * \param   [in]     slots     Slot array (sequence number at offset 0)
+ * \param   [in]     stride    Size of one slot in bytes
+ * \param   [in]     data_off  Offset of the element inside a slot
+ * \param   [in]     value     Element to copy in
+ * \param   [in]     esize     Size of one element in bytes
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+static inline int _trb_mpmc_push(atomic_size_t *tail, size_t mask,
+                                 char *slots, size_t stride, size_t data_off,
+                                 const void *value, size_t esize)
+{
+    size_t pos = atomic_load_explicit(tail, memory_order_relaxed);
+
+    for (;;) {
+        char *slot = slots + (pos & mask) * stride;
+        atomic_size_t *seq = (atomic_size_t *)slot;
+        size_t lap = pos & ~mask;
+        intptr_t dif = (intptr_t)(atomic_load_explicit(seq, memory_order_acquire) - lap);
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(tail, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(slot + data_off, value, esize);
+                atomic_store_explicit(seq, lap + 1, memory_order_release);
+                return 0;
+            }
+        } else if (dif < 0) {
+            return -1;
+        } else {
+            pos = atomic_load_explicit(tail, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * \brief   Claim the slot at head, copy the element out and free the slot
+ *
+ * \param   [in,out] head      Dequeue position shared by all consumers
+ * \param   [in]     mask      capacity - 1
+ * \param   [in]     slots     Slot array (sequence number at offset 0)
+ * \param   [in]     stride    Size of one slot in bytes
+ * \param   [in]     data_off  Offset of the element inside a slot
+ * \param   [out]    value     Destination for the element
+ * \param   [in]     esize     Size of one element in bytes
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+static inline int _trb_mpmc_pop(atomic_size_t *head, size_t mask,
+                                char *slots, size_t stride, size_t data_off,
+                                void *value, size_t esize)
+{
+    size_t pos = atomic_load_explicit(head, memory_order_relaxed);
+
+    for (;;) {
+        char *slot = slots + (pos & mask) * stride;
+        atomic_size_t *seq = (atomic_size_t *)slot;
+        size_t lap = pos & ~mask;
+        intptr_t dif = (intptr_t)(atomic_load_explicit(seq, memory_order_acquire) - (lap + 1));
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(head, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(value, slot + data_off, esize);
+                atomic_store_explicit(seq, lap + mask + 1, memory_order_release);
+                return 0;
+            }
+        } else if (dif < 0) {
+            return -1;
+        } else {
+            pos = atomic_load_explicit(head, memory_order_relaxed);
+        }
+    }
+}
+
+/* Slot layout arguments shared by push and pop */
+#define _trb_mpmc_slots(NAME)\
+    (char *)_trb_##NAME##_buf.slot, sizeof(_trb_##NAME##_buf.slot[0]),\
+    (size_t)((char *)&_trb_##NAME##_buf.slot[0].data - (char *)&_trb_##NAME##_buf.slot[0])
+
+/**
+ * \brief   Get the number of elements currently in the buffer (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_mpmc_size(NAME)\
+    ((size_t)(atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire) -\
+              atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_acquire)))
+
+/**
+ * \brief   Check if the buffer is empty (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_mpmc_is_empty(NAME)\
+    (trb_mpmc_size(NAME) == 0)
+
+/**
+ * \brief   Get the total capacity of the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_mpmc_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Push an element into the buffer (any number of producers)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_mpmc_push(NAME, VALUE_PTR)\
+    _trb_mpmc_push(&_trb_##NAME##_buf.tail, _trb_##NAME##_buf.mask, _trb_mpmc_slots(NAME),\
+                   VALUE_PTR, sizeof(_trb_##NAME##_buf.slot[0].data))
+
+/**
+ * \brief   Pop an element from the buffer (any number of consumers)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_mpmc_pop(NAME, VALUE_PTR)\
+    _trb_mpmc_pop(&_trb_##NAME##_buf.head, _trb_##NAME##_buf.mask, _trb_mpmc_slots(NAME),\
+                  VALUE_PTR, sizeof(_trb_##NAME##_buf.slot[0].data))
+
+#endif /* __TINY_RB_MPMC_H__ */
@@ -0,0 +1,321 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_msg.h
+ *
+ * \brief Variable-length message ring (non-thread-safe)
+ *        A byte ring storing length-prefixed frames. A frame is never split
+ *        across the end of the storage: when it does not fit, a skip marker
+ *        fills the tail and the frame starts again at offset 0, so every
+ *        message can be read in place.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_MSG_H__
+#define __TINY_RB_MSG_H__
+
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Type of the per-frame length header (limits the message size)
+ */
+#ifndef TRB_MSG_LEN_T
+#define TRB_MSG_LEN_T uint16_t
+#endif
+typedef TRB_MSG_LEN_T trb_msg_len_t;
+
+/**
+ * \brief   Frame alignment in bytes; a power of two, at least the size of the
+ *          length header. Payloads start TRB_MSG_ALIGN-aligned relative to
+ *          the storage, which helps when parsing records in place.
+ */
+#ifndef TRB_MSG_ALIGN
+#define TRB_MSG_ALIGN sizeof(trb_msg_len_t)
+#endif
+
+/* Length header value marking the rest of the storage as padding */
+#define _TRB_MSG_SKIP   ((trb_msg_len_t)~(trb_msg_len_t)0)
+
+/**
+ * \brief   Largest payload accepted by trb_msg_push
+ */
+#define TRB_MSG_LEN_MAX ((size_t)_TRB_MSG_SKIP - 1)
+
+/* Bytes taken in the ring by a frame with a len-byte payload */
+#define _TRB_MSG_FRAME(LEN)\
+    ((sizeof(trb_msg_len_t) + (LEN) + TRB_MSG_ALIGN - 1) & ~(size_t)(TRB_MSG_ALIGN - 1))
+
+/* Evaluate to CAPACITY if it is a non-zero multiple of TRB_MSG_ALIGN, else -1 */
+#define _TRB_MSG_CHECK(CAPACITY)\
+    ((((CAPACITY) > 0) && ((CAPACITY) % TRB_MSG_ALIGN) == 0) ? (CAPACITY) : -1)
+
+/**
+ * \brief   Declare a global message ring
+ *
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Storage size in bytes, a multiple of TRB_MSG_ALIGN
+ */
+#define TRB_MSG_DEFINE(NAME, CAPACITY)\
+    struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t used;\
+        size_t count;\
+        TRB_ALIGNAS(TRB_MSG_ALIGN) unsigned char buf[_TRB_MSG_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .head = 0,\
+        .tail = 0,\
+        .used = 0,\
+        .count = 0\
+    }
+
+/**
+ * \brief   Declare a static message ring
+ *
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Storage size in bytes, a multiple of TRB_MSG_ALIGN
+ */
+#define TRB_MSG_DEFINE_STATIC(NAME, CAPACITY)\
+    static TRB_MSG_DEFINE(NAME, CAPACITY)
+
+/**
+ * \brief   Import a global message ring
+ *
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_MSG_IMPORT(NAME)\
+    extern struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t used;\
+        size_t count;\
+        TRB_ALIGNAS(TRB_MSG_ALIGN) unsigned char buf[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Append one frame, wrapping with a skip marker if needed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Not enough contiguous space, or len too large
+ */
+static inline int _trb_msg_push(unsigned char *buf, size_t capacity,
+                                size_t *head, size_t *tail, size_t *used, size_t *count,
+                                const void *data, size_t len)
+{
+    size_t frame = _TRB_MSG_FRAME(len);
+    trb_msg_len_t hdr = (trb_msg_len_t)len;
+
+    if (len > TRB_MSG_LEN_MAX || frame > capacity) {
+        return -1;
+    }
+    if (*used == 0) {
+        /* Restart at offset 0 to offer the largest contiguous run */
+        *head = 0;
+        *tail = 0;
+    }
+    if (*tail > *head || *used == 0) {
+        /* Free space is [tail, capacity) followed by [0, head) */
+        if (capacity - *tail < frame) {
+            trb_msg_len_t skip = _TRB_MSG_SKIP;
+
+            if (*head < frame) {
+                return -1;
+            }
+            memcpy(buf + *tail, &skip, sizeof(skip));
+            *used += capacity - *tail;
+            *tail = 0;
+        }
+    } else if (*head - *tail < frame) {
+        return -1;
+    }
+    memcpy(buf + *tail, &hdr, sizeof(hdr));
+    memcpy(buf + *tail + sizeof(hdr), data, len);
+    *tail += frame;
+    if (*tail == capacity) {
+        *tail = 0;
+    }
+    *used += frame;
+    (*count)++;
+    return 0;
+}
+
+/**
+ * \brief   Locate the oldest frame, consuming a skip marker in front of it
+ *
+ * \return  Payload length, or -1 if the ring is empty
+ */
+static inline long _trb_msg_peek(unsigned char *buf, size_t capacity,
+                                 size_t *head, size_t *used, size_t count,
+                                 unsigned char **payload)
+{
+    trb_msg_len_t hdr;
+
+    if (count == 0) {
+        return -1;
+    }
+    memcpy(&hdr, buf + *head, sizeof(hdr));
+    if (hdr == _TRB_MSG_SKIP) {
+        *used -= capacity - *head;
+        *head = 0;
+        memcpy(&hdr, buf, sizeof(hdr));
+    }
+    *payload = buf + *head + sizeof(hdr);
+    return (long)hdr;
+}
+
+/**
+ * \brief   Drop the oldest frame (must follow a successful _trb_msg_peek)
+ */
+static inline void _trb_msg_release(unsigned char *buf, size_t capacity,
+                                    size_t *head, size_t *used, size_t *count)
+{
+    trb_msg_len_t hdr;
+    size_t frame;
+
+    memcpy(&hdr, buf + *head, sizeof(hdr));
+    frame = _TRB_MSG_FRAME(hdr);
+    *head += frame;
+    if (*head == capacity) {
+        *head = 0;
+    }
+    *used -= frame;
+    (*count)--;
+}
+
+/**
+ * \brief   Copy the oldest frame out and drop it
+ *
+ * \return  Payload length, -1 if empty, -2 if dst_cap is too small (the
+ *          frame stays in the ring)
+ */
+static inline long _trb_msg_pop(unsigned char *buf, size_t capacity,
+                                size_t *head, size_t *used, size_t *count,
+                                void *dst, size_t dst_cap)
+{
+    unsigned char *payload;
+    long len = _trb_msg_peek(buf, capacity, head, used, *count, &payload);
+
+    if (len < 0) {
+        return -1;
+    }
+    if ((size_t)len > dst_cap) {
+        return -2;
+    }
+    memcpy(dst, payload, (size_t)len);
+    _trb_msg_release(buf, capacity, head, used, count);
+    return len;
+}
+
+/**
+ * \brief   Check if the message ring is empty
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_msg_is_empty(NAME)\
+    (_trb_##NAME##_buf.count == 0)
+
+/**
+ * \brief   Get the number of messages currently in the ring
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of messages (size_t)
+ */
+#define trb_msg_count(NAME)\
+    (_trb_##NAME##_buf.count)
+
+/**
+ * \brief   Get the number of storage bytes in use, including headers and
+ *          padding
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Bytes in use (size_t)
+ */
+#define trb_msg_used(NAME)\
+    (_trb_##NAME##_buf.used)
+
+/**
+ * \brief   Clear the message ring (reset to empty state)
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_msg_flush(NAME)\
+    do {\
+        _trb_##NAME##_buf.head = 0;\
+        _trb_##NAME##_buf.tail = 0;\
+        _trb_##NAME##_buf.used = 0;\
+        _trb_##NAME##_buf.count = 0;\
+    } while (0)
+
+/**
+ * \brief   Push a message
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] DATA_PTR  Pointer to the payload
+ * \param   [in] LEN       Payload length in bytes (at most TRB_MSG_LEN_MAX)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Not enough contiguous space, or LEN too large
+ */
+#define trb_msg_push(NAME, DATA_PTR, LEN)\
+    _trb_msg_push(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.head,\
+                  &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.used, &_trb_##NAME##_buf.count,\
+                  DATA_PTR, LEN)
+
+/**
+ * \brief   Pop the oldest message
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] DST_PTR   Destination for the payload
+ * \param   [in]  CAP       Size of the destination in bytes
+ *
+ * \return  - (>= 0) Payload length
+ *          - (-1)   Ring empty
+ *          - (-2)   CAP too small, the message is left in the ring
+ */
+#define trb_msg_pop(NAME, DST_PTR, CAP)\
+    _trb_msg_pop(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.head,\
+                 &_trb_##NAME##_buf.used, &_trb_##NAME##_buf.count, DST_PTR, CAP)
+
+/**
+ * \brief   Expose the oldest message in place without copying
+ *
+ *          The payload stays valid until trb_msg_release or the next pop.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] PTR_PTR   Receives a pointer (unsigned char *) to the payload
+ *
+ * \return  - (>= 0) Payload length
+ *          - (-1)   Ring empty
+ */
+#define trb_msg_peek(NAME, PTR_PTR)\
+    _trb_msg_peek(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.head,\
+                  &_trb_##NAME##_buf.used, _trb_##NAME##_buf.count, PTR_PTR)
+
+/**
+ * \brief   Drop the message returned by trb_msg_peek
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_msg_release(NAME)\
+    _trb_msg_release(_trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, &_trb_##NAME##_buf.head,\
+                     &_trb_##NAME##_buf.used, &_trb_##NAME##_buf.count)
+
+#endif /* __TINY_RB_MSG_H__ */
@@ -0,0 +1,510 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_pmem.h
+ *
+ * \brief Crash-durable ring buffer on persistent memory (single thread)
+ *        The ring lives in a caller-supplied region that survives resets:
+ *        a memory-mapped FRAM/MRAM/flash window, battery-backed SRAM, or an
+ *        mmap'd file (trb_pmem_open on POSIX systems).
+ *
+ *        Every slot carries the sequence number it was written for and a
+ *        CRC-32 of sequence and data. The committed head/tail live in two
+ *        alternating CRC-protected records, so a torn index write leaves
+ *        the previous one valid. A push costs the slot write plus one index
+ *        record write; at boot trb_pmem_recover reads the newest record and
+ *        scans forward only over slots written after it, so recovery time
+ *        does not depend on the capacity.
+ *
+ *        With a commit interval above 1 the index is written every N
+ *        operations: pushes are still found by the forward scan, but up to
+ *        N - 1 pops may be replayed after a reset (at-least-once delivery).
+ *
+ *        trb_pmem_open needs open()/mmap()/ftruncate(): build with -std=gnu99
+ *        or define _GNU_SOURCE (or _POSIX_C_SOURCE >= 200112L) before any
+ *        include. Bare-metal targets use trb_pmem_format/trb_pmem_recover.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_PMEM_H__
+#define __TINY_RB_PMEM_H__
+
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Header magic ("TRBP") and layout version
+ */
+#define TRB_PMEM_MAGIC   0x50425254u
+#define TRB_PMEM_VERSION 1u
+
+/**
+ * \brief   Make the stores to [ADDR, ADDR + LEN) durable before continuing
+ *
+ *          The default only stops the compiler from reordering stores,
+ *          which is enough for FRAM/MRAM on uncached MCU buses and for
+ *          surviving process crashes with an mmap'd file. Override it for
+ *          power-loss safety on cached memory, e.g. msync(MS_SYNC) on a
+ *          page-aligned range, or clwb + sfence on NVDIMM.
+ */
+#ifndef TRB_PMEM_PERSIST
+#if defined(__GNUC__)
+#define TRB_PMEM_PERSIST(ADDR, LEN)\
+    do { (void)(ADDR); (void)(LEN); __asm__ __volatile__("" ::: "memory"); } while (0)
+#else
+#define TRB_PMEM_PERSIST(ADDR, LEN) ((void)(ADDR), (void)(LEN))
+#endif
+#endif
+
+/**
+ * \brief   Default number of operations between index commits
+ */
+#ifndef TRB_PMEM_COMMIT_EVERY
+#define TRB_PMEM_COMMIT_EVERY 1
+#endif
+
+/**
+ * \brief   Committed index record (two copies, newest valid one wins)
+ */
+typedef struct {
+    uint64_t gen;   /**< Incremented on every commit */
+    uint64_t head;
+    uint64_t tail;
+    uint32_t crc;   /**< CRC-32 of gen, head and tail */
+    uint32_t pad;
+} trb_pmem_rec_t;
+
+/**
+ * \brief   Header at the start of the persistent region
+ */
+typedef struct {
+    uint32_t       magic;       /**< TRB_PMEM_MAGIC */
+    uint32_t       version;     /**< TRB_PMEM_VERSION */
+    uint32_t       header_size; /**< sizeof(trb_pmem_hdr_t) */
+    uint32_t       slot_size;   /**< Bytes per slot, tag included */
+    uint64_t       elem_size;   /**< Size of one element in bytes */
+    uint64_t       capacity;    /**< Number of slots (power of two) */
+    uint32_t       crc;         /**< CRC-32 of the fields above */
+    uint32_t       pad;
+    trb_pmem_rec_t rec[2];
+} trb_pmem_hdr_t;
+
+/**
+ * \brief   Tag written in front of every element
+ */
+typedef struct {
+    uint64_t seq;   /**< Position + 1 the slot was written for, 0 if never */
+    uint32_t crc;   /**< CRC-32 of seq and the element */
+    uint32_t pad;
+} trb_pmem_tag_t;
+
+/**
+ * \brief   Handle of a persistent ring (lives in RAM)
+ */
+typedef struct {
+    trb_pmem_hdr_t *hdr;
+    unsigned char  *slots;
+    size_t          slot_size;
+    size_t          esize;
+    size_t          map_size;       /**< Mapping size when opened by trb_pmem_open */
+    uint64_t        mask;
+    uint64_t        head;
+    uint64_t        tail;
+    uint64_t        gen;
+    uint32_t        commit_every;   /**< Operations between index commits */
+    uint32_t        pending;
+} trb_pmem_t;
+
+/* CRC-32 (IEEE, reflected), nibble table */
+static inline uint32_t _trb_pmem_crc32(uint32_t crc, const void *data, size_t len)
+{
+    static const uint32_t tab[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+    };
+    const unsigned char *p = (const unsigned char *)data;
+
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ tab[crc & 0x0F];
+        crc = (crc >> 4) ^ tab[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static inline uint32_t _trb_pmem_rec_crc(const trb_pmem_rec_t *r)
+{
+    return _trb_pmem_crc32(0, r, offsetof(trb_pmem_rec_t, crc));
+}
+
+static inline uint32_t _trb_pmem_slot_crc(uint64_t seq, const void *data, size_t esize)
+{
+    return _trb_pmem_crc32(_trb_pmem_crc32(0, &seq, sizeof(seq)), data, esize);
+}
+
+static inline size_t _trb_pmem_slot_size(size_t elem_size)
+{
+    return (sizeof(trb_pmem_tag_t) + elem_size + 7) & ~(size_t)7;
+}
+
+static inline trb_pmem_tag_t *_trb_pmem_slot(const trb_pmem_t *pm, uint64_t pos)
+{
+    return (trb_pmem_tag_t *)(pm->slots + (size_t)(pos & pm->mask) * pm->slot_size);
+}
+
+/* Slot at pos holds a complete element written for that position */
+static inline int _trb_pmem_slot_valid(const trb_pmem_t *pm, uint64_t pos)
+{
+    const trb_pmem_tag_t *tag = _trb_pmem_slot(pm, pos);
+
+    return tag->seq == pos + 1 && tag->crc == _trb_pmem_slot_crc(tag->seq, tag + 1, pm->esize);
+}
+
+static inline void _trb_pmem_bind(trb_pmem_t *pm, void *region)
+{
+    pm->hdr = (trb_pmem_hdr_t *)region;
+    pm->slot_size = pm->hdr->slot_size;
+    pm->esize = (size_t)pm->hdr->elem_size;
+    pm->slots = (unsigned char *)region +
+                ((sizeof(trb_pmem_hdr_t) + TRB_CACHELINE_SIZE - 1) & ~(size_t)(TRB_CACHELINE_SIZE - 1));
+    pm->mask = pm->hdr->capacity - 1;
+    pm->commit_every = TRB_PMEM_COMMIT_EVERY;
+    pm->pending = 0;
+}
+
+/**
+ * \brief   Get the region size needed for a ring
+ *
+ * \param   [in] elem_size Size of one element in bytes
+ * \param   [in] capacity  Number of elements
+ *
+ * \return  Size in bytes
+ */
+static inline size_t trb_pmem_region_size(size_t elem_size, size_t capacity)
+{
+    return ((sizeof(trb_pmem_hdr_t) + TRB_CACHELINE_SIZE - 1) & ~(size_t)(TRB_CACHELINE_SIZE - 1)) +
+           _trb_pmem_slot_size(elem_size) * capacity;
+}
+
+/**
+ * \brief   Write the committed head/tail into the older index record
+ *
+ *          Called automatically every commit_every operations; call it
+ *          directly to make pops durable before a planned shutdown.
+ *
+ * \param   [in] pm        Ring handle
+ */
+static inline void trb_pmem_commit(trb_pmem_t *pm)
+{
+    trb_pmem_rec_t *r = &pm->hdr->rec[(pm->gen + 1) & 1];
+
+    r->gen = pm->gen + 1;
+    r->head = pm->head;
+    r->tail = pm->tail;
+    r->crc = _trb_pmem_rec_crc(r);
+    TRB_PMEM_PERSIST(r, sizeof(*r));
+    pm->gen++;
+    pm->pending = 0;
+}
+
+/**
+ * \brief   Initialize an empty ring in a region, discarding its contents
+ *
+ * \param   [out] pm          Handle to initialize
+ * \param   [in]  region      Persistent region (8-byte aligned)
+ * \param   [in]  region_size Size of the region in bytes
+ * \param   [in]  elem_size   Size of one element in bytes
+ * \param   [in]  capacity    Number of elements, a power of two
+ *
+ * \return  - (0)  Success
+ *          - (-1) Invalid argument or region too small
+ */
+static inline int trb_pmem_format(trb_pmem_t *pm, void *region, size_t region_size,
+                                  size_t elem_size, size_t capacity)
+{
+    trb_pmem_hdr_t *hdr = (trb_pmem_hdr_t *)region;
+    size_t i;
+
+    if (elem_size == 0 || elem_size > UINT32_MAX / 2 || capacity == 0 ||
+        (capacity & (capacity - 1)) != 0 ||
+        capacity > (SIZE_MAX - sizeof(trb_pmem_hdr_t) - TRB_CACHELINE_SIZE) / _trb_pmem_slot_size(elem_size) ||
+        region_size < trb_pmem_region_size(elem_size, capacity)) {
+        return -1;
+    }
+
+    /* Invalidate the header first so a reset during format is detected */
+    hdr->magic = 0;
+    TRB_PMEM_PERSIST(&hdr->magic, sizeof(hdr->magic));
+    hdr->version = TRB_PMEM_VERSION;
+    hdr->header_size = (uint32_t)sizeof(trb_pmem_hdr_t);
+    hdr->slot_size = (uint32_t)_trb_pmem_slot_size(elem_size);
+    hdr->elem_size = elem_size;
+    hdr->capacity = capacity;
+    hdr->pad = 0;
+    memset(hdr->rec, 0, sizeof(hdr->rec));
+    _trb_pmem_bind(pm, region);
+    for (i = 0; i < capacity; i++) {
+        _trb_pmem_slot(pm, i)->seq = 0;
+    }
+    TRB_PMEM_PERSIST(region, trb_pmem_region_size(elem_size, capacity));
+
+    hdr->magic = TRB_PMEM_MAGIC;
+    hdr->crc = _trb_pmem_crc32(0, hdr, offsetof(trb_pmem_hdr_t, crc));
+    TRB_PMEM_PERSIST(hdr, sizeof(*hdr));
+
+    pm->head = 0;
+    pm->tail = 0;
+    pm->gen = 0;
+    return 0;
+}
+
+/**
+ * \brief   Bind a ring previously formatted in a region and restore its state
+ *
+ *          Reads the newest valid index record, then extends tail over the
+ *          slots written after that commit.
+ *
+ * \param   [out] pm          Handle to initialize
+ * \param   [in]  region      Persistent region
+ * \param   [in]  region_size Size of the region in bytes
+ *
+ * \return  - (0)  Success
+ *          - (-1) Region not formatted or header corrupted
+ */
+static inline int trb_pmem_recover(trb_pmem_t *pm, void *region, size_t region_size)
+{
+    const trb_pmem_hdr_t *hdr = (const trb_pmem_hdr_t *)region;
+    const trb_pmem_rec_t *best = NULL;
+    uint64_t head = 0;
+    uint64_t tail = 0;
+    uint64_t n;
+    int i;
+
+    if (region_size < sizeof(trb_pmem_hdr_t) ||
+        hdr->magic != TRB_PMEM_MAGIC || hdr->version != TRB_PMEM_VERSION ||
+        hdr->header_size != sizeof(trb_pmem_hdr_t) ||
+        hdr->crc != _trb_pmem_crc32(0, hdr, offsetof(trb_pmem_hdr_t, crc)) ||
+        hdr->elem_size == 0 || hdr->capacity == 0 || (hdr->capacity & (hdr->capacity - 1)) != 0 ||
+        hdr->slot_size != _trb_pmem_slot_size((size_t)hdr->elem_size) ||
+        region_size < trb_pmem_region_size((size_t)hdr->elem_size, (size_t)hdr->capacity)) {
+        return -1;
+    }
+    _trb_pmem_bind(pm, region);
+
+    for (i = 0; i < 2; i++) {
+        const trb_pmem_rec_t *r = &hdr->rec[i];
+
+        if (r->crc == _trb_pmem_rec_crc(r) && r->tail - r->head <= hdr->capacity &&
+            (best == NULL || r->gen > best->gen)) {
+            best = r;
+        }
+    }
+    pm->gen = 0;
+    if (best != NULL) {
+        head = best->head;
+        tail = best->tail;
+        pm->gen = best->gen;
+    }
+
+    /* Slots written after the last commit */
+    for (n = 0; n < hdr->capacity && _trb_pmem_slot_valid(pm, tail); n++) {
+        tail++;
+    }
+    if (tail - head > hdr->capacity) {
+        head = tail - hdr->capacity;
+    }
+    pm->head = head;
+    pm->tail = tail;
+    if (n > 0) {
+        trb_pmem_commit(pm);
+    }
+    return 0;
+}
+
+/**
+ * \brief   Get the number of elements in the ring
+ */
+static inline size_t trb_pmem_size(const trb_pmem_t *pm)
+{
+    return (size_t)(pm->tail - pm->head);
+}
+
+/**
+ * \brief   Get the total capacity of the ring
+ */
+static inline size_t trb_pmem_capacity(const trb_pmem_t *pm)
+{
+    return (size_t)pm->hdr->capacity;
+}
+
+static inline void _trb_pmem_step(trb_pmem_t *pm)
+{
+    if (++pm->pending >= pm->commit_every) {
+        trb_pmem_commit(pm);
+    }
+}
+
+static inline void _trb_pmem_write(trb_pmem_t *pm, const void *value)
+{
+    trb_pmem_tag_t *tag = _trb_pmem_slot(pm, pm->tail);
+    uint64_t seq = pm->tail + 1;
+
+    /* Data and CRC first, the tag makes the slot valid for recovery */
+    memcpy(tag + 1, value, pm->esize);
+    tag->crc = _trb_pmem_slot_crc(seq, value, pm->esize);
+    TRB_PMEM_PERSIST(tag, pm->slot_size);
+    tag->seq = seq;
+    TRB_PMEM_PERSIST(&tag->seq, sizeof(tag->seq));
+    pm->tail++;
+    _trb_pmem_step(pm);
+}
+
+/**
+ * \brief   Push an element into the ring
+ *
+ * \param   [in] pm        Ring handle
+ * \param   [in] value     Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Ring full
+ */
+static inline int trb_pmem_push(trb_pmem_t *pm, const void *value)
+{
+    if (pm->tail - pm->head == pm->hdr->capacity) {
+        return -1;
+    }
+    _trb_pmem_write(pm, value);
+    return 0;
+}
+
+/**
+ * \brief   Push an element, overwriting the oldest one if the ring is full
+ *
+ *          The dropped element needs no extra write: recovery derives head
+ *          from tail - capacity.
+ *
+ * \param   [in] pm        Ring handle
+ * \param   [in] value     Pointer to the element to be pushed
+ */
+static inline void trb_pmem_force_push(trb_pmem_t *pm, const void *value)
+{
+    if (pm->tail - pm->head == pm->hdr->capacity) {
+        pm->head++;
+    }
+    _trb_pmem_write(pm, value);
+}
+
+/**
+ * \brief   Pop the oldest element from the ring
+ *
+ * \param   [in]  pm        Ring handle
+ * \param   [out] value     Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Ring empty
+ *          - (-2) Slot failed its CRC check; it is dropped and value untouched
+ */
+static inline int trb_pmem_pop(trb_pmem_t *pm, void *value)
+{
+    int ret = 0;
+
+    if (pm->tail == pm->head) {
+        return -1;
+    }
+    if (_trb_pmem_slot_valid(pm, pm->head)) {
+        memcpy(value, _trb_pmem_slot(pm, pm->head) + 1, pm->esize);
+    } else {
+        ret = -2;
+    }
+    pm->head++;
+    _trb_pmem_step(pm);
+    return ret;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * \brief   Map a ring stored in a file, recovering it or formatting a new one
+ *
+ *          An existing file is recovered if its header matches elem_size
+ *          and capacity; otherwise the file is (re)formatted.
+ *
+ * \param   [out] pm        Handle to initialize
+ * \param   [in]  path      File path
+ * \param   [in]  elem_size Size of one element in bytes
+ * \param   [in]  capacity  Number of elements, a power of two
+ *
+ * \return  - (1)  Existing ring recovered
+ *          - (0)  New ring formatted
+ *          - (-1) Invalid argument, I/O or mapping failure
+ */
+static inline int trb_pmem_open(trb_pmem_t *pm, const char *path, size_t elem_size, size_t capacity)
+{
+    size_t map_size = trb_pmem_region_size(elem_size, capacity);
+    struct stat st;
+    void *base;
+    int ret;
+    int fd;
+
+    if (elem_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+    fd = open(path, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || ((size_t)st.st_size < map_size && ftruncate(fd, (off_t)map_size) != 0)) {
+        close(fd);
+        return -1;
+    }
+    base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+
+    if (trb_pmem_recover(pm, base, map_size) == 0 &&
+        pm->esize == elem_size && pm->hdr->capacity == capacity) {
+        ret = 1;
+    } else if (trb_pmem_format(pm, base, map_size, elem_size, capacity) == 0) {
+        ret = 0;
+    } else {
+        munmap(base, map_size);
+        return -1;
+    }
+    pm->map_size = map_size;
+    return ret;
+}
+
+/**
+ * \brief   Commit, flush and unmap a ring opened with trb_pmem_open
+ */
+static inline void trb_pmem_close(trb_pmem_t *pm)
+{
+    trb_pmem_commit(pm);
+    msync(pm->hdr, pm->map_size, MS_SYNC);
+    munmap(pm->hdr, pm->map_size);
+    pm->hdr = NULL;
+    pm->slots = NULL;
+}
+
+#endif
+
+#endif /* __TINY_RB_PMEM_H__ */
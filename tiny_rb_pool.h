@@ -0,0 +1,307 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_pool.h
+ *
+ * \brief Pooled queues built from fixed-size segments (non-thread-safe)
+ *        A pool is a static slab of SEGMENTS segments of SEG_CAP elements.
+ *        Any number of small trb_pool_q_t queues draw segments from it as
+ *        they grow, chain them in FIFO order and give each segment back as
+ *        soon as it is drained, so memory follows the actual backlog
+ *        instead of the worst case of every queue. Within a segment push
+ *        and pop are plain indexed copies.
+ *
+ *        A zero-initialized trb_pool_q_t is an empty queue, and a pool
+ *        needs no init call: unused segments are handed out in order before
+ *        the free list is used.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_POOL_H__
+#define __TINY_RB_POOL_H__
+
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Pool bookkeeping (segment references are index + 1, 0 = none)
+ */
+typedef struct {
+    size_t   seg_cap;   /**< Elements per segment */
+    size_t   segments;  /**< Segments in the slab */
+    size_t   used;      /**< Segments currently owned by queues */
+    uint32_t bump;      /**< Segments never handed out start here */
+    uint32_t free;      /**< Head of the free list */
+} trb_pool_meta_t;
+
+/**
+ * \brief   One queue drawing from a pool
+ */
+typedef struct {
+    uint32_t head_seg;  /**< Segment holding the oldest element */
+    uint32_t tail_seg;  /**< Segment receiving the next push */
+    uint32_t head;      /**< Read index inside head_seg */
+    uint32_t tail;      /**< Write index inside tail_seg */
+    size_t   count;     /**< Elements in the queue */
+} trb_pool_q_t;
+
+/**
+ * \brief   Declare a global segment pool
+ *
+ * \param   [in] TYPE      Data type of the queue elements
+ * \param   [in] NAME      Name of the pool (used in macro expansions)
+ * \param   [in] SEG_CAP   Elements per segment
+ * \param   [in] SEGMENTS  Number of segments shared by all queues
+ */
+#define TRB_POOL_DEFINE(TYPE, NAME, SEG_CAP, SEGMENTS)\
+    struct {\
+        trb_pool_meta_t meta;\
+        struct {\
+            uint32_t next;\
+            TYPE     buf[SEG_CAP];\
+        } seg[SEGMENTS];\
+    } _trb_##NAME##_pool = {\
+        .meta = { SEG_CAP, SEGMENTS, 0, 0, 0 }\
+    }
+
+/**
+ * \brief   Declare a static segment pool
+ *
+ * \param   [in] TYPE      Data type of the queue elements
+ * \param   [in] NAME      Name of the pool (used in macro expansions)
+ * \param   [in] SEG_CAP   Elements per segment
+ * \param   [in] SEGMENTS  Number of segments shared by all queues
+ */
+#define TRB_POOL_DEFINE_STATIC(TYPE, NAME, SEG_CAP, SEGMENTS)\
+    static TRB_POOL_DEFINE(TYPE, NAME, SEG_CAP, SEGMENTS)
+
+/**
+ * \brief   Import a global segment pool
+ *
+ * \param   [in] TYPE      Data type of the queue elements
+ * \param   [in] NAME      Name of the pool (used in macro expansions)
+ * \param   [in] SEG_CAP   Elements per segment used in the definition
+ */
+#define TRB_POOL_IMPORT(TYPE, NAME, SEG_CAP)\
+    extern struct {\
+        trb_pool_meta_t meta;\
+        struct {\
+            uint32_t next;\
+            TYPE     buf[SEG_CAP];\
+        } seg[];\
+    } _trb_##NAME##_pool
+
+/* Type-erased view of a pool's segment array */
+typedef struct {
+    trb_pool_meta_t *meta;
+    char            *segs;
+    size_t           stride;
+    size_t           data_off;
+    size_t           esize;
+} _trb_pool_ctx_t;
+
+#define _TRB_POOL_CTX(NAME)\
+    (&(_trb_pool_ctx_t){\
+        &_trb_##NAME##_pool.meta, (char *)_trb_##NAME##_pool.seg, sizeof(_trb_##NAME##_pool.seg[0]),\
+        (size_t)((char *)_trb_##NAME##_pool.seg[0].buf - (char *)&_trb_##NAME##_pool.seg[0]),\
+        sizeof(_trb_##NAME##_pool.seg[0].buf[0])\
+    })
+
+static inline uint32_t *_trb_pool_next(const _trb_pool_ctx_t *c, uint32_t s)
+{
+    return (uint32_t *)(c->segs + (size_t)(s - 1) * c->stride);
+}
+
+static inline unsigned char *_trb_pool_elem(const _trb_pool_ctx_t *c, uint32_t s, uint32_t i)
+{
+    return (unsigned char *)c->segs + (size_t)(s - 1) * c->stride + c->data_off + (size_t)i * c->esize;
+}
+
+static inline uint32_t _trb_pool_alloc(const _trb_pool_ctx_t *c)
+{
+    trb_pool_meta_t *m = c->meta;
+    uint32_t s = m->free;
+
+    if (s != 0) {
+        m->free = *_trb_pool_next(c, s);
+    } else if (m->bump < m->segments) {
+        s = ++m->bump;
+    } else {
+        return 0;
+    }
+    *_trb_pool_next(c, s) = 0;
+    m->used++;
+    return s;
+}
+
+static inline void _trb_pool_release(const _trb_pool_ctx_t *c, uint32_t s)
+{
+    *_trb_pool_next(c, s) = c->meta->free;
+    c->meta->free = s;
+    c->meta->used--;
+}
+
+static inline int _trb_pool_push(const _trb_pool_ctx_t *c, trb_pool_q_t *q, const void *value)
+{
+    if (q->tail_seg == 0 || q->tail == c->meta->seg_cap) {
+        uint32_t s = _trb_pool_alloc(c);
+
+        if (s == 0) {
+            return -1;
+        }
+        if (q->tail_seg != 0) {
+            *_trb_pool_next(c, q->tail_seg) = s;
+        } else {
+            q->head_seg = s;
+            q->head = 0;
+        }
+        q->tail_seg = s;
+        q->tail = 0;
+    }
+    memcpy(_trb_pool_elem(c, q->tail_seg, q->tail++), value, c->esize);
+    q->count++;
+    return 0;
+}
+
+static inline int _trb_pool_pop(const _trb_pool_ctx_t *c, trb_pool_q_t *q, void *value, int remove)
+{
+    uint32_t s = q->head_seg;
+
+    if (q->count == 0) {
+        return -1;
+    }
+    memcpy(value, _trb_pool_elem(c, s, q->head), c->esize);
+    if (!remove) {
+        return 0;
+    }
+    q->head++;
+    q->count--;
+    if (q->count == 0) {
+        q->head_seg = 0;
+        q->tail_seg = 0;
+        q->head = 0;
+        q->tail = 0;
+        _trb_pool_release(c, s);
+    } else if (q->head == c->meta->seg_cap) {
+        q->head_seg = *_trb_pool_next(c, s);
+        q->head = 0;
+        _trb_pool_release(c, s);
+    }
+    return 0;
+}
+
+static inline void _trb_pool_flush(const _trb_pool_ctx_t *c, trb_pool_q_t *q)
+{
+    uint32_t s = q->head_seg;
+
+    while (q->count != 0 && s != 0) {
+        uint32_t next = *_trb_pool_next(c, s);
+
+        _trb_pool_release(c, s);
+        if (s == q->tail_seg) {
+            break;
+        }
+        s = next;
+    }
+    memset(q, 0, sizeof(*q));
+}
+
+/**
+ * \brief   Get the number of elements in a queue
+ *
+ * \param   [in] Q_PTR     Pointer to the queue
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_pool_size(Q_PTR)\
+    ((Q_PTR)->count)
+
+/**
+ * \brief   Check if a queue is empty
+ *
+ * \param   [in] Q_PTR     Pointer to the queue
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_pool_is_empty(Q_PTR)\
+    ((Q_PTR)->count == 0)
+
+/**
+ * \brief   Get the number of segments not owned by any queue
+ *
+ * \param   [in] NAME      Pool name
+ *
+ * \return  Free segment count (size_t)
+ */
+#define trb_pool_free_segments(NAME)\
+    (_trb_##NAME##_pool.meta.segments - _trb_##NAME##_pool.meta.used)
+
+/**
+ * \brief   Get the number of elements per segment
+ *
+ * \param   [in] NAME      Pool name
+ *
+ * \return  Segment capacity (size_t)
+ */
+#define trb_pool_segment_capacity(NAME)\
+    (_trb_##NAME##_pool.meta.seg_cap)
+
+/**
+ * \brief   Push an element to the tail of a queue
+ *
+ * \param   [in] NAME      Pool name
+ * \param   [in] Q_PTR     Pointer to the queue
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) A new segment was needed and the pool is exhausted
+ */
+#define trb_pool_push(NAME, Q_PTR, VALUE_PTR)\
+    _trb_pool_push(_TRB_POOL_CTX(NAME), Q_PTR, VALUE_PTR)
+
+/**
+ * \brief   Pop the oldest element of a queue, returning drained segments
+ *
+ * \param   [in]  NAME      Pool name
+ * \param   [in]  Q_PTR     Pointer to the queue
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Queue empty
+ */
+#define trb_pool_pop(NAME, Q_PTR, VALUE_PTR)\
+    _trb_pool_pop(_TRB_POOL_CTX(NAME), Q_PTR, VALUE_PTR, 1)
+
+/**
+ * \brief   Peek at the oldest element of a queue without removing it
+ *
+ * \param   [in]  NAME      Pool name
+ * \param   [in]  Q_PTR     Pointer to the queue
+ * \param   [out] VALUE_PTR Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Queue empty
+ */
+#define trb_pool_peek(NAME, Q_PTR, VALUE_PTR)\
+    _trb_pool_pop(_TRB_POOL_CTX(NAME), Q_PTR, VALUE_PTR, 0)
+
+/**
+ * \brief   Empty a queue and return all its segments to the pool
+ *
+ * \param   [in] NAME      Pool name
+ * \param   [in] Q_PTR     Pointer to the queue
+ */
+#define trb_pool_flush(NAME, Q_PTR)\
+    _trb_pool_flush(_TRB_POOL_CTX(NAME), Q_PTR)
+
+#endif /* __TINY_RB_POOL_H__ */
@@ -0,0 +1,257 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_prio.h
+ *
+ * \brief Multi-lane priority ring buffer (non-thread-safe)
+ *        LANES independent FIFO lanes of CAPACITY elements each share one
+ *        buffer. A bitmap records which lanes hold data, so the highest
+ *        non-empty lane is found with a single count-leading-zeros
+ *        instruction instead of polling every lane. Higher lane numbers
+ *        have higher priority; order within a lane is FIFO.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_PRIO_H__
+#define __TINY_RB_PRIO_H__
+
+#include "tiny_rb.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * \brief   Maximum number of lanes (bits in the occupancy bitmap)
+ */
+#define TRB_PRIO_MAX_LANES 64
+
+/**
+ * \brief   Per-lane indices
+ */
+typedef struct {
+    size_t head;
+    size_t tail;
+    size_t count;
+} trb_prio_lane_t;
+
+/*
+ * Compile-time check that the lane count fits the bitmap
+ * An illegal value produces a negative array size
+ */
+#define _TRB_PRIO_LANES_CHECK(LANES)\
+    ((((LANES) > 0) && ((LANES) <= TRB_PRIO_MAX_LANES)) ? (LANES) : -1)
+
+/**
+ * \brief   Declare a global multi-lane priority buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] LANES     Number of priority lanes (1 to TRB_PRIO_MAX_LANES)
+ * \param   [in] CAPACITY  Maximum capacity of each lane
+ */
+#define TRB_PRIO_DEFINE(TYPE, NAME, LANES, CAPACITY)\
+    struct {\
+        size_t capacity;\
+        size_t lanes;\
+        unsigned long long bitmap;\
+        trb_prio_lane_t lane[_TRB_PRIO_LANES_CHECK(LANES)];\
+        TYPE   buf[LANES][CAPACITY];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .lanes = LANES,\
+        .bitmap = 0\
+    }
+
+/**
+ * \brief   Declare a static multi-lane priority buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] LANES     Number of priority lanes (1 to TRB_PRIO_MAX_LANES)
+ * \param   [in] CAPACITY  Maximum capacity of each lane
+ */
+#define TRB_PRIO_DEFINE_STATIC(TYPE, NAME, LANES, CAPACITY)\
+    static TRB_PRIO_DEFINE(TYPE, NAME, LANES, CAPACITY)
+
+/**
+ * \brief   Import a global multi-lane priority buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] LANES     Number of lanes used in the definition
+ * \param   [in] CAPACITY  Capacity used in the definition
+ */
+#define TRB_PRIO_IMPORT(TYPE, NAME, LANES, CAPACITY)\
+    extern struct {\
+        size_t capacity;\
+        size_t lanes;\
+        unsigned long long bitmap;\
+        trb_prio_lane_t lane[_TRB_PRIO_LANES_CHECK(LANES)];\
+        TYPE   buf[LANES][CAPACITY];\
+    } _trb_##NAME##_buf
+
+/* Index of the highest set bit, bitmap must be non-zero */
+static inline int _trb_prio_top(unsigned long long bitmap)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(bitmap);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long idx;
+    _BitScanReverse64(&idx, bitmap);
+    return (int)idx;
+#else
+    int idx = 0;
+
+    while (bitmap >>= 1) {
+        idx++;
+    }
+    return idx;
+#endif
+}
+
+static inline int _trb_prio_push(unsigned char *buf, size_t esize, size_t capacity, size_t lanes,
+                                 trb_prio_lane_t *lane, unsigned long long *bitmap,
+                                 size_t l, const void *src)
+{
+    trb_prio_lane_t *q;
+
+    if (l >= lanes || lane[l].count == capacity) {
+        return -1;
+    }
+    q = &lane[l];
+    memcpy(buf + (l * capacity + q->tail) * esize, src, esize);
+    q->tail = _trb_wrap(q->tail + 1, capacity);
+    q->count++;
+    *bitmap |= 1ULL << l;
+    return 0;
+}
+
+static inline int _trb_prio_pop(unsigned char *buf, size_t esize, size_t capacity,
+                                trb_prio_lane_t *lane, unsigned long long *bitmap,
+                                void *dst, int remove)
+{
+    trb_prio_lane_t *q;
+    int l;
+
+    if (*bitmap == 0) {
+        return -1;
+    }
+    l = _trb_prio_top(*bitmap);
+    q = &lane[l];
+    memcpy(dst, buf + ((size_t)l * capacity + q->head) * esize, esize);
+    if (remove) {
+        q->head = _trb_wrap(q->head + 1, capacity);
+        if (--q->count == 0) {
+            *bitmap &= ~(1ULL << l);
+        }
+    }
+    return l;
+}
+
+/**
+ * \brief   Check if all lanes are empty
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1) Empty
+ *          - (0) Not empty
+ */
+#define trb_prio_is_empty(NAME)\
+    (_trb_##NAME##_buf.bitmap == 0)
+
+/**
+ * \brief   Get the number of elements in one lane
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] LANE      Lane index
+ *
+ * \return  Number of elements in the lane
+ */
+#define trb_prio_size(NAME, LANE)\
+    (_trb_##NAME##_buf.lane[LANE].count)
+
+/**
+ * \brief   Get the capacity of each lane
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Maximum number of elements per lane
+ */
+#define trb_prio_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the highest non-empty lane
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (>=0) Lane index
+ *          - (-1)  All lanes empty
+ */
+#define trb_prio_top(NAME)\
+    (trb_prio_is_empty(NAME) ? (-1) : _trb_prio_top(_trb_##NAME##_buf.bitmap))
+
+/**
+ * \brief   Clear all lanes
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_prio_flush(NAME)\
+    do {\
+        memset(_trb_##NAME##_buf.lane, 0, sizeof(_trb_##NAME##_buf.lane));\
+        _trb_##NAME##_buf.bitmap = 0;\
+    } while (0)
+
+/**
+ * \brief   Push an element to the tail of a lane
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] LANE      Lane index, higher is more urgent
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Lane full or lane index out of range
+ */
+#define trb_prio_push(NAME, LANE, VALUE_PTR)\
+    _trb_prio_push((unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0][0]),\
+                   _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.lanes, _trb_##NAME##_buf.lane,\
+                   &_trb_##NAME##_buf.bitmap, (size_t)(LANE), VALUE_PTR)
+
+/**
+ * \brief   Pop the oldest element of the highest non-empty lane
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (>=0) Lane the element was taken from
+ *          - (-1)  All lanes empty
+ */
+#define trb_prio_pop(NAME, VALUE_PTR)\
+    _trb_prio_pop((unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0][0]),\
+                  _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.lane,\
+                  &_trb_##NAME##_buf.bitmap, VALUE_PTR, 1)
+
+/**
+ * \brief   Peek the element trb_prio_pop would return without removing it
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the peeked element will be copied
+ *
+ * \return  - (>=0) Lane the element is in
+ *          - (-1)  All lanes empty
+ */
+#define trb_prio_peek(NAME, VALUE_PTR)\
+    _trb_prio_pop((unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0][0]),\
+                  _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.lane,\
+                  &_trb_##NAME##_buf.bitmap, VALUE_PTR, 0)
+
+#endif /* __TINY_RB_PRIO_H__ */
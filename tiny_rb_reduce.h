@@ -0,0 +1,544 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_reduce.h
+ *
+ * \brief Vectorized reductions (sum, min/max, mean) over the live elements
+ *        of a TRB_RB_DEFINE buffer of int16_t, int32_t or float (C11).
+ *        The live data is processed as its one or two contiguous spans, so
+ *        there is no per-element wrap check. Kernels use AVX2, SSE2 or NEON
+ *        when the compiler targets them, with a scalar fallback; define
+ *        TRB_NO_SIMD to force the scalar code.
+ *
+ *        Integer sums are accumulated in 64 bits, float sums in double
+ *        (32-bit ARM has no double NEON lanes and sums floats in scalar
+ *        double code). Power-of-two buffers use the trb_pow2_* forms.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_REDUCE_H__
+#define __TINY_RB_REDUCE_H__
+
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+#if !defined(TRB_NO_SIMD) && defined(__AVX2__)
+#define _TRB_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(TRB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define _TRB_SIMD_SSE2
+#include <emmintrin.h>
+#elif !defined(TRB_NO_SIMD) && defined(__ARM_NEON)
+#define _TRB_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_TRB_SIMD_SSE2)
+/* Widen four int32 lanes to int64 and add them to a two-lane accumulator */
+static inline __m128i _trb_sse2_add_i32_to_i64(__m128i acc, __m128i v)
+{
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v);
+
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+}
+
+/* SSE2 has no 32-bit signed min/max */
+static inline __m128i _trb_sse2_min_epi32(__m128i a, __m128i b)
+{
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+static inline __m128i _trb_sse2_max_epi32(__m128i a, __m128i b)
+{
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+#endif
+
+/**
+ * \brief   Sum n contiguous int16_t values
+ */
+static inline int64_t trb_span_sum_i16(const int16_t *p, size_t n)
+{
+    int64_t sum = 0;
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    int64_t lane[4];
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i s = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(p + i)), ones);
+
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(s)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(s, 1)));
+    }
+    _mm256_storeu_si256((__m256i *)lane, acc);
+    sum = lane[0] + lane[1] + lane[2] + lane[3];
+#elif defined(_TRB_SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    int64_t lane[2];
+
+    for (; i + 8 <= n; i += 8) {
+        acc = _trb_sse2_add_i32_to_i64(acc,
+                _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(p + i)), ones));
+    }
+    _mm_storeu_si128((__m128i *)lane, acc);
+    sum = lane[0] + lane[1];
+#elif defined(_TRB_SIMD_NEON)
+    int64x2_t acc = vdupq_n_s64(0);
+
+    for (; i + 8 <= n; i += 8) {
+        acc = vpadalq_s32(acc, vpaddlq_s16(vld1q_s16(p + i)));
+    }
+    sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif
+    for (; i < n; i++) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+/**
+ * \brief   Sum n contiguous int32_t values
+ */
+static inline int64_t trb_span_sum_i32(const int32_t *p, size_t n)
+{
+    int64_t sum = 0;
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256i acc = _mm256_setzero_si256();
+    int64_t lane[4];
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    _mm256_storeu_si256((__m256i *)lane, acc);
+    sum = lane[0] + lane[1] + lane[2] + lane[3];
+#elif defined(_TRB_SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    int64_t lane[2];
+
+    for (; i + 4 <= n; i += 4) {
+        acc = _trb_sse2_add_i32_to_i64(acc, _mm_loadu_si128((const __m128i *)(p + i)));
+    }
+    _mm_storeu_si128((__m128i *)lane, acc);
+    sum = lane[0] + lane[1];
+#elif defined(_TRB_SIMD_NEON)
+    int64x2_t acc = vdupq_n_s64(0);
+
+    for (; i + 4 <= n; i += 4) {
+        acc = vpadalq_s32(acc, vld1q_s32(p + i));
+    }
+    sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+#endif
+    for (; i < n; i++) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+/**
+ * \brief   Sum n contiguous float values, widened to double before adding
+ */
+static inline double trb_span_sum_f32(const float *p, size_t n)
+{
+    double sum = 0.0;
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    double lane[4];
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(p + i);
+
+        acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    _mm256_storeu_pd(lane, _mm256_add_pd(acc0, acc1));
+    sum = (lane[0] + lane[1]) + (lane[2] + lane[3]);
+#elif defined(_TRB_SIMD_SSE2)
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    double lane[2];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+
+        acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+        acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    _mm_storeu_pd(lane, _mm_add_pd(acc0, acc1));
+    sum = lane[0] + lane[1];
+#elif defined(_TRB_SIMD_NEON) && defined(__aarch64__)
+    float64x2_t acc0 = vdupq_n_f64(0.0);
+    float64x2_t acc1 = vdupq_n_f64(0.0);
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(p + i);
+
+        acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v)));
+        acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v));
+    }
+    sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+    for (; i < n; i++) {
+        sum += (double)p[i];
+    }
+    return sum;
+}
+
+/**
+ * \brief   Fold n contiguous int16_t values into *mn and *mx
+ *          (both must already hold a value, e.g. the first element)
+ */
+static inline void trb_span_minmax_i16(const int16_t *p, size_t n, int16_t *mn, int16_t *mx)
+{
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256i vmn = _mm256_set1_epi16(*mn);
+    __m256i vmx = _mm256_set1_epi16(*mx);
+    int16_t lmn[16], lmx[16];
+
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+
+        vmn = _mm256_min_epi16(vmn, v);
+        vmx = _mm256_max_epi16(vmx, v);
+    }
+    _mm256_storeu_si256((__m256i *)lmn, vmn);
+    _mm256_storeu_si256((__m256i *)lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 16; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_SSE2)
+    __m128i vmn = _mm_set1_epi16(*mn);
+    __m128i vmx = _mm_set1_epi16(*mx);
+    int16_t lmn[8], lmx[8];
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+
+        vmn = _mm_min_epi16(vmn, v);
+        vmx = _mm_max_epi16(vmx, v);
+    }
+    _mm_storeu_si128((__m128i *)lmn, vmn);
+    _mm_storeu_si128((__m128i *)lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 8; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_NEON)
+    int16x8_t vmn = vdupq_n_s16(*mn);
+    int16x8_t vmx = vdupq_n_s16(*mx);
+    int16_t lmn[8], lmx[8];
+
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(p + i);
+
+        vmn = vminq_s16(vmn, v);
+        vmx = vmaxq_s16(vmx, v);
+    }
+    vst1q_s16(lmn, vmn);
+    vst1q_s16(lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 8; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#endif
+    for (; i < n; i++) {
+        *mn = (p[i] < *mn) ? p[i] : *mn;
+        *mx = (p[i] > *mx) ? p[i] : *mx;
+    }
+}
+
+/**
+ * \brief   Fold n contiguous int32_t values into *mn and *mx
+ *          (both must already hold a value, e.g. the first element)
+ */
+static inline void trb_span_minmax_i32(const int32_t *p, size_t n, int32_t *mn, int32_t *mx)
+{
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256i vmn = _mm256_set1_epi32(*mn);
+    __m256i vmx = _mm256_set1_epi32(*mx);
+    int32_t lmn[8], lmx[8];
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+
+        vmn = _mm256_min_epi32(vmn, v);
+        vmx = _mm256_max_epi32(vmx, v);
+    }
+    _mm256_storeu_si256((__m256i *)lmn, vmn);
+    _mm256_storeu_si256((__m256i *)lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 8; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_SSE2)
+    __m128i vmn = _mm_set1_epi32(*mn);
+    __m128i vmx = _mm_set1_epi32(*mx);
+    int32_t lmn[4], lmx[4];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+
+        vmn = _trb_sse2_min_epi32(vmn, v);
+        vmx = _trb_sse2_max_epi32(vmx, v);
+    }
+    _mm_storeu_si128((__m128i *)lmn, vmn);
+    _mm_storeu_si128((__m128i *)lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 4; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_NEON)
+    int32x4_t vmn = vdupq_n_s32(*mn);
+    int32x4_t vmx = vdupq_n_s32(*mx);
+    int32_t lmn[4], lmx[4];
+
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = vld1q_s32(p + i);
+
+        vmn = vminq_s32(vmn, v);
+        vmx = vmaxq_s32(vmx, v);
+    }
+    vst1q_s32(lmn, vmn);
+    vst1q_s32(lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 4; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#endif
+    for (; i < n; i++) {
+        *mn = (p[i] < *mn) ? p[i] : *mn;
+        *mx = (p[i] > *mx) ? p[i] : *mx;
+    }
+}
+
+/**
+ * \brief   Fold n contiguous float values into *mn and *mx
+ *          (both must already hold a value, e.g. the first element)
+ */
+static inline void trb_span_minmax_f32(const float *p, size_t n, float *mn, float *mx)
+{
+    size_t i = 0;
+
+#if defined(_TRB_SIMD_AVX2)
+    __m256 vmn = _mm256_set1_ps(*mn);
+    __m256 vmx = _mm256_set1_ps(*mx);
+    float lmn[8], lmx[8];
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(p + i);
+
+        vmn = _mm256_min_ps(vmn, v);
+        vmx = _mm256_max_ps(vmx, v);
+    }
+    _mm256_storeu_ps(lmn, vmn);
+    _mm256_storeu_ps(lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 8; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_SSE2)
+    __m128 vmn = _mm_set1_ps(*mn);
+    __m128 vmx = _mm_set1_ps(*mx);
+    float lmn[4], lmx[4];
+
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(p + i);
+
+        vmn = _mm_min_ps(vmn, v);
+        vmx = _mm_max_ps(vmx, v);
+    }
+    _mm_storeu_ps(lmn, vmn);
+    _mm_storeu_ps(lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 4; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#elif defined(_TRB_SIMD_NEON)
+    float32x4_t vmn = vdupq_n_f32(*mn);
+    float32x4_t vmx = vdupq_n_f32(*mx);
+    float lmn[4], lmx[4];
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(p + i);
+
+        vmn = vminq_f32(vmn, v);
+        vmx = vmaxq_f32(vmx, v);
+    }
+    vst1q_f32(lmn, vmn);
+    vst1q_f32(lmx, vmx);
+    for (n -= i, p += i, i = 0; i < 4; i++) {
+        *mn = (lmn[i] < *mn) ? lmn[i] : *mn;
+        *mx = (lmx[i] > *mx) ? lmx[i] : *mx;
+    }
+    i = 0;
+#endif
+    for (; i < n; i++) {
+        *mn = (p[i] < *mn) ? p[i] : *mn;
+        *mx = (p[i] > *mx) ? p[i] : *mx;
+    }
+}
+
+/*
+ * Ring wrappers: split the live data at the wrap point and run the span
+ * kernel on each part
+ */
+#define _TRB_REDUCE_RING(T, SUFFIX, SUM_T)\
+    static inline SUM_T _trb_ring_sum_##SUFFIX(const T *buf, size_t capacity, size_t head, size_t count)\
+    {\
+        size_t n1 = _trb_span(capacity, head, count, count);\
+        \
+        return trb_span_sum_##SUFFIX(buf + head, n1) + trb_span_sum_##SUFFIX(buf, count - n1);\
+    }\
+    static inline int _trb_ring_minmax_##SUFFIX(const T *buf, size_t capacity, size_t head, size_t count,\
+                                                T *mn, T *mx)\
+    {\
+        size_t n1 = _trb_span(capacity, head, count, count);\
+        \
+        if (count == 0) {\
+            return -1;\
+        }\
+        *mn = *mx = buf[head];\
+        trb_span_minmax_##SUFFIX(buf + head, n1, mn, mx);\
+        trb_span_minmax_##SUFFIX(buf, count - n1, mn, mx);\
+        return 0;\
+    }
+
+_TRB_REDUCE_RING(int16_t, i16, int64_t)
+_TRB_REDUCE_RING(int32_t, i32, int64_t)
+_TRB_REDUCE_RING(float, f32, double)
+
+#define _TRB_RING_ARGS(NAME)\
+    _trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head, _trb_##NAME##_buf.count
+
+/* Power-of-two buffers have free-running indices: mask the head, count is tail - head */
+#define _TRB_POW2_RING_ARGS(NAME)\
+    _trb_##NAME##_buf.buf, _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head & _trb_##NAME##_buf.mask,\
+    trb_pow2_size(NAME)
+
+/**
+ * \brief   Sum the live elements of a buffer
+ *
+ * \param   [in] NAME      Buffer name (TRB_RB_DEFINE, TYPE int16_t,
+ *                         int32_t or float)
+ *
+ * \return  Sum (int64_t for integer buffers, double for float buffers),
+ *          0 if empty
+ */
+#define trb_sum(NAME)\
+    _Generic(_trb_##NAME##_buf.buf[0],\
+        int16_t: _trb_ring_sum_i16,\
+        int32_t: _trb_ring_sum_i32,\
+        float:   _trb_ring_sum_f32)(_TRB_RING_ARGS(NAME))
+
+/**
+ * \brief   Get the smallest and largest live elements of a buffer
+ *
+ * \param   [in]  NAME      Buffer name (TRB_RB_DEFINE, TYPE int16_t,
+ *                          int32_t or float)
+ * \param   [out] MIN_PTR   Receives the minimum (pointer to TYPE)
+ * \param   [out] MAX_PTR   Receives the maximum (pointer to TYPE)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_minmax(NAME, MIN_PTR, MAX_PTR)\
+    _Generic(_trb_##NAME##_buf.buf[0],\
+        int16_t: _trb_ring_minmax_i16,\
+        int32_t: _trb_ring_minmax_i32,\
+        float:   _trb_ring_minmax_f32)(_TRB_RING_ARGS(NAME), MIN_PTR, MAX_PTR)
+
+/**
+ * \brief   Get the mean of the live elements of a buffer
+ *
+ * \param   [in] NAME      Buffer name (TRB_RB_DEFINE, TYPE int16_t,
+ *                         int32_t or float)
+ *
+ * \return  Mean (double), 0 if empty
+ */
+#define trb_mean(NAME)\
+    (_trb_##NAME##_buf.count == 0 ? 0.0 :\
+    (double)trb_sum(NAME) / (double)_trb_##NAME##_buf.count)
+
+/**
+ * \brief   Sum the live elements of a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name (TRB_RB_DEFINE_POW2, TYPE int16_t,
+ *                         int32_t or float)
+ *
+ * \return  Sum (int64_t for integer buffers, double for float buffers),
+ *          0 if empty
+ */
+#define trb_pow2_sum(NAME)\
+    _Generic(_trb_##NAME##_buf.buf[0],\
+        int16_t: _trb_ring_sum_i16,\
+        int32_t: _trb_ring_sum_i32,\
+        float:   _trb_ring_sum_f32)(_TRB_POW2_RING_ARGS(NAME))
+
+/**
+ * \brief   Get the smallest and largest live elements of a power-of-two buffer
+ *
+ * \param   [in]  NAME      Buffer name (TRB_RB_DEFINE_POW2, TYPE int16_t,
+ *                          int32_t or float)
+ * \param   [out] MIN_PTR   Receives the minimum (pointer to TYPE)
+ * \param   [out] MAX_PTR   Receives the maximum (pointer to TYPE)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_pow2_minmax(NAME, MIN_PTR, MAX_PTR)\
+    _Generic(_trb_##NAME##_buf.buf[0],\
+        int16_t: _trb_ring_minmax_i16,\
+        int32_t: _trb_ring_minmax_i32,\
+        float:   _trb_ring_minmax_f32)(_TRB_POW2_RING_ARGS(NAME), MIN_PTR, MAX_PTR)
+
+/**
+ * \brief   Get the mean of the live elements of a power-of-two buffer
+ *
+ * \param   [in] NAME      Buffer name (TRB_RB_DEFINE_POW2, TYPE int16_t,
+ *                         int32_t or float)
+ *
+ * \return  Mean (double), 0 if empty
+ */
+#define trb_pow2_mean(NAME)\
+    (trb_pow2_size(NAME) == 0 ? 0.0 :\
+    (double)trb_pow2_sum(NAME) / (double)trb_pow2_size(NAME))
+
+#endif /* __TINY_RB_REDUCE_H__ */
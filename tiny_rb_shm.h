@@ -0,0 +1,368 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_shm.h
+ *
+ * \brief Lock-free SPSC ring buffer in POSIX shared memory for cross-process
+ *        zero-copy IPC. The mapping holds a versioned header followed by the
+ *        element storage; indices are free-running counters and the storage
+ *        is located by offset, so the region can be mapped at any address
+ *        in any process. One process pushes, one process pops, either by
+ *        copy (push/pop) or in place in the mapping (reserve/commit and
+ *        peek_span/release).
+ *
+ *        Needs shm_open()/mmap(): build with -std=gnu11 or define
+ *        _GNU_SOURCE (or _POSIX_C_SOURCE >= 200112L) before any include;
+ *        older glibc also needs -lrt.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_SHM_H__
+#define __TINY_RB_SHM_H__
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tiny_rb.h"
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "tiny_rb_shm.h needs lock-free 64-bit atomics");
+
+/**
+ * \brief   Header magic ("TRBS") and layout version
+ */
+#define TRB_SHM_MAGIC   0x53425254u
+#define TRB_SHM_VERSION 1u
+
+/**
+ * \brief   Header at the start of the shared mapping
+ *
+ *          All fields have fixed widths so 32-bit and 64-bit processes agree
+ *          on the layout. head and tail sit on their own cache lines.
+ */
+typedef struct {
+    _Atomic uint32_t magic;         /**< TRB_SHM_MAGIC once initialized */
+    uint32_t         version;       /**< TRB_SHM_VERSION */
+    uint32_t         header_size;   /**< sizeof(trb_shm_hdr_t) of the creator */
+    uint32_t         cacheline;     /**< TRB_CACHELINE_SIZE of the creator */
+    uint64_t         elem_size;     /**< Size of one element in bytes */
+    uint64_t         capacity;      /**< Number of elements (power of two) */
+    uint64_t         data_offset;   /**< Offset of the element storage */
+    _Alignas(TRB_CACHELINE_SIZE) _Atomic uint64_t head;
+    _Alignas(TRB_CACHELINE_SIZE) _Atomic uint64_t tail;
+} trb_shm_hdr_t;
+
+/**
+ * \brief   Process-local handle of a shared-memory ring
+ *
+ *          The layout fields are copied out of the header once, when the
+ *          ring is created or attached, so the fast paths only read head
+ *          and tail from the mapping and a later write to the shared header
+ *          cannot move them outside this process's mapping.
+ */
+typedef struct {
+    trb_shm_hdr_t *hdr;
+    unsigned char *data;
+    size_t         map_size;
+    uint64_t       capacity;
+    uint64_t       mask;
+    size_t         esize;
+} trb_shm_t;
+
+/* Take the layout from validated values, never from the mapping again */
+static inline void _trb_shm_bind(trb_shm_t *shm, void *base, size_t map_size,
+                                 size_t data_offset, size_t elem_size, uint64_t capacity)
+{
+    shm->hdr = (trb_shm_hdr_t *)base;
+    shm->data = (unsigned char *)base + data_offset;
+    shm->map_size = map_size;
+    shm->capacity = capacity;
+    shm->mask = capacity - 1;
+    shm->esize = elem_size;
+}
+
+/**
+ * \brief   Create and map a new shared-memory ring
+ *
+ * \param   [out] shm       Handle to initialize
+ * \param   [in]  name      shm_open name, e.g. "/telemetry"
+ * \param   [in]  elem_size Size of one element in bytes
+ * \param   [in]  capacity  Number of elements, a power of two
+ *
+ * \return  - (0)  Success
+ *          - (-1) Invalid argument, name already exists or mapping failed
+ */
+static inline int trb_shm_create(trb_shm_t *shm, const char *name,
+                                 size_t elem_size, size_t capacity)
+{
+    size_t offset = (sizeof(trb_shm_hdr_t) + TRB_CACHELINE_SIZE - 1) & ~(size_t)(TRB_CACHELINE_SIZE - 1);
+    size_t map_size;
+    trb_shm_hdr_t *hdr;
+    void *base;
+    int fd;
+
+    if (elem_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        capacity > (SIZE_MAX - offset) / elem_size) {
+        return -1;
+    }
+    map_size = offset + elem_size * capacity;
+
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t)map_size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        shm_unlink(name);
+        return -1;
+    }
+
+    hdr = (trb_shm_hdr_t *)base;
+    hdr->version = TRB_SHM_VERSION;
+    hdr->header_size = (uint32_t)sizeof(trb_shm_hdr_t);
+    hdr->cacheline = TRB_CACHELINE_SIZE;
+    hdr->elem_size = elem_size;
+    hdr->capacity = capacity;
+    hdr->data_offset = offset;
+    atomic_store_explicit(&hdr->head, 0, memory_order_relaxed);
+    atomic_store_explicit(&hdr->tail, 0, memory_order_relaxed);
+    /* Publishing the magic last lets attach reject half-initialized rings */
+    atomic_store_explicit(&hdr->magic, TRB_SHM_MAGIC, memory_order_release);
+
+    _trb_shm_bind(shm, base, map_size, offset, elem_size, capacity);
+    return 0;
+}
+
+/**
+ * \brief   Map an existing shared-memory ring and validate its header
+ *
+ * \param   [out] shm       Handle to initialize
+ * \param   [in]  name      shm_open name used by the creator
+ *
+ * \return  - (0)  Success
+ *          - (-1) Not found, not initialized yet, or incompatible layout
+ */
+static inline int trb_shm_attach(trb_shm_t *shm, const char *name)
+{
+    trb_shm_hdr_t *hdr;
+    struct stat st;
+    size_t map_size;
+    uint64_t elem_size;
+    uint64_t capacity;
+    uint64_t offset;
+    void *base;
+    int fd;
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(trb_shm_hdr_t)) {
+        close(fd);
+        return -1;
+    }
+    map_size = (size_t)st.st_size;
+    base = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+
+    hdr = (trb_shm_hdr_t *)base;
+    if (atomic_load_explicit(&hdr->magic, memory_order_acquire) != TRB_SHM_MAGIC ||
+        hdr->version != TRB_SHM_VERSION ||
+        hdr->header_size != sizeof(trb_shm_hdr_t) ||
+        hdr->cacheline != TRB_CACHELINE_SIZE) {
+        munmap(base, map_size);
+        return -1;
+    }
+    /* Validate one snapshot of the layout and bind exactly that snapshot */
+    elem_size = hdr->elem_size;
+    capacity = hdr->capacity;
+    offset = hdr->data_offset;
+    if (elem_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        elem_size > SIZE_MAX || capacity > SIZE_MAX ||
+        offset < sizeof(trb_shm_hdr_t) || offset > map_size ||
+        capacity > (map_size - (size_t)offset) / (size_t)elem_size) {
+        munmap(base, map_size);
+        return -1;
+    }
+
+    _trb_shm_bind(shm, base, map_size, (size_t)offset, (size_t)elem_size, capacity);
+    return 0;
+}
+
+/**
+ * \brief   Unmap a shared-memory ring from this process
+ */
+static inline void trb_shm_detach(trb_shm_t *shm)
+{
+    munmap(shm->hdr, shm->map_size);
+    shm->hdr = NULL;
+    shm->data = NULL;
+}
+
+/**
+ * \brief   Remove the shared-memory name; existing mappings stay valid
+ *
+ * \return  - (0)  Success
+ *          - (-1) Failure
+ */
+static inline int trb_shm_unlink(const char *name)
+{
+    return shm_unlink(name);
+}
+
+/**
+ * \brief   Get the number of elements currently in the ring (snapshot)
+ */
+static inline size_t trb_shm_size(const trb_shm_t *shm)
+{
+    return (size_t)(atomic_load_explicit(&shm->hdr->tail, memory_order_acquire) -
+                    atomic_load_explicit(&shm->hdr->head, memory_order_acquire));
+}
+
+/**
+ * \brief   Get the total capacity of the ring
+ */
+static inline size_t trb_shm_capacity(const trb_shm_t *shm)
+{
+    return (size_t)shm->capacity;
+}
+
+/**
+ * \brief   Push an element into the ring (producer process only)
+ *
+ * \param   [in] shm       Ring handle
+ * \param   [in] value     Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Ring full
+ */
+static inline int trb_shm_push(trb_shm_t *shm, const void *value)
+{
+    uint64_t tail = atomic_load_explicit(&shm->hdr->tail, memory_order_relaxed);
+
+    if (tail - atomic_load_explicit(&shm->hdr->head, memory_order_acquire) == shm->capacity) {
+        return -1;
+    }
+    memcpy(shm->data + (size_t)(tail & shm->mask) * shm->esize, value, shm->esize);
+    atomic_store_explicit(&shm->hdr->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * \brief   Pop an element from the ring (consumer process only)
+ *
+ * \param   [in]  shm       Ring handle
+ * \param   [out] value     Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Ring empty
+ */
+static inline int trb_shm_pop(trb_shm_t *shm, void *value)
+{
+    uint64_t head = atomic_load_explicit(&shm->hdr->head, memory_order_relaxed);
+
+    if (head == atomic_load_explicit(&shm->hdr->tail, memory_order_acquire)) {
+        return -1;
+    }
+    memcpy(value, shm->data + (size_t)(head & shm->mask) * shm->esize, shm->esize);
+    atomic_store_explicit(&shm->hdr->head, head + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * \brief   Reserve a contiguous free region in the mapping for in-place
+ *          writes (producer process only)
+ *
+ *          Nothing becomes visible to the consumer until trb_shm_commit. The
+ *          region never wraps; commit and reserve again for the slots at the
+ *          start of the storage.
+ *
+ * \param   [in]  shm       Ring handle
+ * \param   [out] ptr       Receives a pointer to the first reserved slot
+ * \param   [in]  max       Maximum number of slots wanted
+ *
+ * \return  Number of contiguous slots reserved, 0 if full
+ */
+static inline size_t trb_shm_reserve(trb_shm_t *shm, void **ptr, size_t max)
+{
+    uint64_t tail = atomic_load_explicit(&shm->hdr->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&shm->hdr->head, memory_order_acquire);
+    size_t idx = (size_t)(tail & shm->mask);
+
+    *ptr = shm->data + idx * shm->esize;
+    return _trb_span((size_t)shm->capacity, idx, (size_t)(shm->capacity - (tail - head)), max);
+}
+
+/**
+ * \brief   Publish n slots written in place after trb_shm_reserve
+ *          (producer process only)
+ *
+ * \param   [in] shm       Ring handle
+ * \param   [in] n         Number of slots to commit (at most the reserved count)
+ */
+static inline void trb_shm_commit(trb_shm_t *shm, size_t n)
+{
+    uint64_t tail = atomic_load_explicit(&shm->hdr->tail, memory_order_relaxed);
+
+    atomic_store_explicit(&shm->hdr->tail, tail + n, memory_order_release);
+}
+
+/**
+ * \brief   Expose the contiguous run of elements at the head for in-place
+ *          reads (consumer process only)
+ *
+ *          The elements stay owned by the consumer until trb_shm_release.
+ *          When the data wraps, only the part up to the end of the storage
+ *          is returned; release it and peek again for the rest.
+ *
+ * \param   [in]  shm       Ring handle
+ * \param   [out] ptr       Receives a pointer to the oldest element
+ *
+ * \return  Number of contiguous elements readable, 0 if empty
+ */
+static inline size_t trb_shm_peek_span(trb_shm_t *shm, const void **ptr)
+{
+    uint64_t head = atomic_load_explicit(&shm->hdr->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&shm->hdr->tail, memory_order_acquire);
+    size_t idx = (size_t)(head & shm->mask);
+    size_t used = (size_t)(tail - head);
+
+    *ptr = shm->data + idx * shm->esize;
+    return _trb_span((size_t)shm->capacity, idx, used, used);
+}
+
+/**
+ * \brief   Hand n slots read in place after trb_shm_peek_span back to the
+ *          producer (consumer process only)
+ *
+ * \param   [in] shm       Ring handle
+ * \param   [in] n         Number of elements to release (at most the peeked count)
+ */
+static inline void trb_shm_release(trb_shm_t *shm, size_t n)
+{
+    uint64_t head = atomic_load_explicit(&shm->hdr->head, memory_order_relaxed);
+
+    atomic_store_explicit(&shm->hdr->head, head + n, memory_order_release);
+}
+
+#endif /* __TINY_RB_SHM_H__ */
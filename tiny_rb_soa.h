@@ -0,0 +1,252 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_soa.h
+ *
+ * \brief Struct-of-arrays ring buffer (non-thread-safe)
+ *        Each field of the element type is stored in its own contiguous
+ *        column sharing one head/tail, so a scan of one field touches only
+ *        that field's memory. Fields are given as an X-macro list:
+ *
+ *          #define USER_FIELDS(X, A) X(int, a, A) X(float, b, A)
+ *          TRB_SOA_DEFINE(user_type_t, soa, 256, USER_FIELDS);
+ *
+ *        Every field of the list must be a member of TYPE with that type.
+ *        The buffer has the TRB_RB_DEFINE count fields, so trb_size,
+ *        trb_is_empty, trb_is_full and friends work on it.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_SOA_H__
+#define __TINY_RB_SOA_H__
+
+#include "tiny_rb.h"
+
+/* X-macro callbacks: column declaration, scatter on push, gather on pop */
+#define _TRB_SOA_COLUMN(T, F, CAPACITY) T F[CAPACITY];
+#define _TRB_SOA_PUT(T, F, NAME) _trb_##NAME##_buf.col.F[_trb_##NAME##_buf.tail] = v->F;
+#define _TRB_SOA_GET(T, F, NAME) v->F = _trb_##NAME##_buf.col.F[_trb_##NAME##_buf.head];
+
+#define _TRB_SOA_STRUCT(FIELDS, CAPACITY)\
+    struct {\
+        size_t capacity;\
+        size_t head;\
+        size_t tail;\
+        size_t count;\
+        struct {\
+            FIELDS(_TRB_SOA_COLUMN, CAPACITY)\
+        } col;\
+    }
+
+/*
+ * Per-buffer record operations, generated because the field list is needed.
+ * The trailing prototype takes the semicolon written after the DEFINE.
+ */
+#define _TRB_SOA_OPS(TYPE, NAME, FIELDS)\
+    static inline int _trb_soa_##NAME##_push(const TYPE *v)\
+    {\
+        if (trb_is_full(NAME)) {\
+            return -1;\
+        }\
+        FIELDS(_TRB_SOA_PUT, NAME)\
+        _trb_##NAME##_buf.tail = _trb_wrap(_trb_##NAME##_buf.tail + 1, _trb_##NAME##_buf.capacity);\
+        _trb_##NAME##_buf.count++;\
+        return 0;\
+    }\
+    static inline int _trb_soa_##NAME##_pop(TYPE *v, int remove)\
+    {\
+        if (trb_is_empty(NAME)) {\
+            return -1;\
+        }\
+        FIELDS(_TRB_SOA_GET, NAME)\
+        if (remove) {\
+            _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity);\
+            _trb_##NAME##_buf.count--;\
+        }\
+        return 0;\
+    }\
+    static inline int _trb_soa_##NAME##_push(const TYPE *v)
+
+/**
+ * \brief   Declare a global struct-of-arrays ring buffer
+ *
+ * \param   [in] TYPE      Element (record) type pushed and popped
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer
+ * \param   [in] FIELDS    X-macro list FIELDS(X, A) expanding X(type, field, A)
+ *                         for every stored field
+ */
+#define TRB_SOA_DEFINE(TYPE, NAME, CAPACITY, FIELDS)\
+    _TRB_SOA_STRUCT(FIELDS, CAPACITY) _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .head = 0,\
+        .tail = 0,\
+        .count = 0\
+    };\
+    _TRB_SOA_OPS(TYPE, NAME, FIELDS)
+
+/**
+ * \brief   Declare a static struct-of-arrays ring buffer
+ *
+ * \param   [in] TYPE      Element (record) type pushed and popped
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer
+ * \param   [in] FIELDS    X-macro field list
+ */
+#define TRB_SOA_DEFINE_STATIC(TYPE, NAME, CAPACITY, FIELDS)\
+    static TRB_SOA_DEFINE(TYPE, NAME, CAPACITY, FIELDS)
+
+/**
+ * \brief   Import a global struct-of-arrays ring buffer
+ *
+ * \param   [in] TYPE      Element (record) type pushed and popped
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Capacity used in the definition
+ * \param   [in] FIELDS    X-macro field list used in the definition
+ */
+#define TRB_SOA_IMPORT(TYPE, NAME, CAPACITY, FIELDS)\
+    extern _TRB_SOA_STRUCT(FIELDS, CAPACITY) _trb_##NAME##_buf;\
+    _TRB_SOA_OPS(TYPE, NAME, FIELDS)
+
+/**
+ * \brief   Push a record, scattering its fields into the columns
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the record to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_soa_push(NAME, VALUE_PTR)\
+    _trb_soa_##NAME##_push(VALUE_PTR)
+
+/**
+ * \brief   Push a record, overwriting the oldest one if the buffer is full
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the record to be pushed
+ */
+#define trb_soa_force_push(NAME, VALUE_PTR)\
+    do {\
+        if (trb_is_full(NAME)) {\
+            _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity);\
+            _trb_##NAME##_buf.count--;\
+        }\
+        (void)_trb_soa_##NAME##_push(VALUE_PTR);\
+    } while (0)
+
+/**
+ * \brief   Pop the oldest record, gathering its fields from the columns
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped record will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_soa_pop(NAME, VALUE_PTR)\
+    _trb_soa_##NAME##_pop(VALUE_PTR, 1)
+
+/**
+ * \brief   Peek at the oldest record without removing it
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the record will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_soa_peek(NAME, VALUE_PTR)\
+    _trb_soa_##NAME##_pop(VALUE_PTR, 0)
+
+/**
+ * \brief   Get a pointer to one field of the i-th oldest record
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] FIELD     Field (column) name
+ * \param   [in] I         Index from the oldest record (0 = oldest)
+ *
+ * \return  Pointer to the field, NULL if I >= trb_size(NAME)
+ */
+#define trb_soa_at(NAME, FIELD, I)\
+    (((size_t)(I) < _trb_##NAME##_buf.count) ?\
+    &_trb_##NAME##_buf.col.FIELD[_trb_wrap(_trb_##NAME##_buf.head + (size_t)(I), _trb_##NAME##_buf.capacity)] : NULL)
+
+/**
+ * \brief   Get the live part of one column as up to two contiguous regions
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [in]  FIELD     Field (column) name
+ * \param   [out] PTR1_PTR  Receives the start of the first region (oldest values)
+ * \param   [out] LEN1_PTR  Receives the length of the first region
+ * \param   [out] PTR2_PTR  Receives the start of the second region
+ * \param   [out] LEN2_PTR  Receives the length of the second region (0 if none)
+ *
+ * \return  Number of non-empty regions (0, 1 or 2)
+ */
+#define trb_soa_spans(NAME, FIELD, PTR1_PTR, LEN1_PTR, PTR2_PTR, LEN2_PTR)\
+    (*(PTR1_PTR) = &_trb_##NAME##_buf.col.FIELD[_trb_##NAME##_buf.head],\
+    *(PTR2_PTR) = &_trb_##NAME##_buf.col.FIELD[0],\
+    _trb_spans(_trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head, _trb_##NAME##_buf.count,\
+               LEN1_PTR, LEN2_PTR))
+
+/*
+ * Column reductions, available when tiny_rb_reduce.h is also included
+ * (C11, column type int16_t, int32_t or float)
+ */
+#define _TRB_SOA_COL_ARGS(NAME, FIELD)\
+    _trb_##NAME##_buf.col.FIELD, _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head, _trb_##NAME##_buf.count
+
+/**
+ * \brief   Sum one column with the SIMD kernels of tiny_rb_reduce.h
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] FIELD     Field (column) name
+ *
+ * \return  Sum (int64_t for integer columns, double for float columns),
+ *          0 if empty
+ */
+#define trb_soa_sum(NAME, FIELD)\
+    _Generic(_trb_##NAME##_buf.col.FIELD[0],\
+        int16_t: _trb_ring_sum_i16,\
+        int32_t: _trb_ring_sum_i32,\
+        float:   _trb_ring_sum_f32)(_TRB_SOA_COL_ARGS(NAME, FIELD))
+
+/**
+ * \brief   Get the smallest and largest values of one column
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [in]  FIELD     Field (column) name
+ * \param   [out] MIN_PTR   Receives the minimum
+ * \param   [out] MAX_PTR   Receives the maximum
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_soa_minmax(NAME, FIELD, MIN_PTR, MAX_PTR)\
+    _Generic(_trb_##NAME##_buf.col.FIELD[0],\
+        int16_t: _trb_ring_minmax_i16,\
+        int32_t: _trb_ring_minmax_i32,\
+        float:   _trb_ring_minmax_f32)(_TRB_SOA_COL_ARGS(NAME, FIELD), MIN_PTR, MAX_PTR)
+
+/**
+ * \brief   Get the mean of one column
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] FIELD     Field (column) name
+ *
+ * \return  Mean (double), 0 if empty
+ */
+#define trb_soa_mean(NAME, FIELD)\
+    (_trb_##NAME##_buf.count == 0 ? 0.0 :\
+    (double)trb_soa_sum(NAME, FIELD) / (double)_trb_##NAME##_buf.count)
+
+#endif /* __TINY_RB_SOA_H__ */
@@ -0,0 +1,269 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_spsc.h
+ *
+ * \brief Lock-free single-producer/single-consumer ring buffer (C11 atomics)
+ *        Exactly one context may push and exactly one context may pop.
+ *        The producer owns tail, the consumer owns head; each index lives on
+ *        its own cache line and is published with release/acquire ordering.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_SPSC_H__
+#define __TINY_RB_SPSC_H__
+
+#include <stdatomic.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Number of elements staged by trb_spsc_push_local before the new
+ *          tail is published automatically
+ */
+#ifndef TRB_SPSC_BATCH
+#define TRB_SPSC_BATCH 32
+#endif
+
+/**
+ * \brief   Define TRB_WAIT before including this header (or include
+ *          tiny_rb_wait.h first) to embed wait channels in every SPSC buffer.
+ *          trb_spsc_flush (and so trb_spsc_push) and trb_spsc_pop then wake
+ *          threads parked in trb_spsc_pop_wait / trb_spsc_push_wait. It
+ *          changes the buffer layout, so it must be set the same way in every
+ *          translation unit that shares a buffer.
+ */
+#ifdef TRB_WAIT
+#include "tiny_rb_wait.h"
+#define _TRB_SPSC_WAIT_FIELDS\
+    _Alignas(TRB_CACHELINE_SIZE) trb_wait_chan_t not_empty;\
+    _Alignas(TRB_CACHELINE_SIZE) trb_wait_chan_t not_full;
+#define _TRB_SPSC_WAKE(NAME, CHAN) _trb_wait_signal(&_trb_##NAME##_buf.CHAN)
+#else
+#define _TRB_SPSC_WAIT_FIELDS
+#define _TRB_SPSC_WAKE(NAME, CHAN) ((void)0)
+#endif
+
+/**
+ * \brief   Declare a global SPSC ring buffer
+ *
+ *          head and tail are free-running counters, so no shared count is
+ *          written by both sides and CAPACITY must be a power of two.
+ *          Each side keeps a cached copy of the other side's index on its
+ *          own cache line and only re-reads the shared one when the cached
+ *          value says the buffer is full (producer) or empty (consumer).
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_SPSC_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        size_t tail_cache;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        size_t head_cache;\
+        size_t staged;\
+        _TRB_SPSC_WAIT_FIELDS\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        TYPE   buf[_TRB_POW2_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .head = 0,\
+        .tail = 0,\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1\
+    }
+
+/**
+ * \brief   Declare a static SPSC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_SPSC_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_SPSC_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global SPSC ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_SPSC_IMPORT(TYPE, NAME)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t head;\
+        size_t tail_cache;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t tail;\
+        size_t head_cache;\
+        size_t staged;\
+        _TRB_SPSC_WAIT_FIELDS\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        TYPE   buf[];\
+    } _trb_##NAME##_buf
+
+/* Index accessors: own index is relaxed, the other side's index is acquired */
+#define _trb_spsc_head_own(NAME)\
+    atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_relaxed)
+#define _trb_spsc_head_acq(NAME)\
+    atomic_load_explicit(&_trb_##NAME##_buf.head, memory_order_acquire)
+#define _trb_spsc_tail_own(NAME)\
+    atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_relaxed)
+#define _trb_spsc_tail_acq(NAME)\
+    atomic_load_explicit(&_trb_##NAME##_buf.tail, memory_order_acquire)
+
+/* Consumer: refresh the cached tail only when it shows no data */
+static inline int _trb_spsc_has_data(atomic_size_t *tail, size_t *tail_cache, size_t head)
+{
+    if ((ptrdiff_t)(*tail_cache - head) > 0) {
+        return 1;
+    }
+    *tail_cache = atomic_load_explicit(tail, memory_order_acquire);
+    return (ptrdiff_t)(*tail_cache - head) > 0;
+}
+
+/* Producer: refresh the cached head only when it shows no room at pos */
+static inline int _trb_spsc_has_room(atomic_size_t *head, size_t *head_cache, size_t pos, size_t capacity)
+{
+    if (pos - *head_cache < capacity) {
+        return 1;
+    }
+    *head_cache = atomic_load_explicit(head, memory_order_acquire);
+    return pos - *head_cache < capacity;
+}
+
+#define _trb_spsc_readable(NAME)\
+    _trb_spsc_has_data(&_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.tail_cache, _trb_spsc_head_own(NAME))
+#define _trb_spsc_stage_pos(NAME)\
+    (_trb_spsc_tail_own(NAME) + _trb_##NAME##_buf.staged)
+#define _trb_spsc_writable(NAME)\
+    _trb_spsc_has_room(&_trb_##NAME##_buf.head, &_trb_##NAME##_buf.head_cache,\
+                       _trb_spsc_stage_pos(NAME), _trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the number of elements currently in the buffer
+ *
+ *          The result is a snapshot; it is exact only when called from the
+ *          producer or the consumer while the other side is idle.
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_spsc_size(NAME)\
+    ((size_t)(_trb_spsc_tail_acq(NAME) - _trb_spsc_head_acq(NAME)))
+
+/**
+ * \brief   Check if the buffer is empty (consumer side)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_spsc_is_empty(NAME)\
+    (_trb_spsc_tail_acq(NAME) == _trb_spsc_head_own(NAME))
+
+/**
+ * \brief   Check if the buffer is full (producer side)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Full
+ *          - (0): Not full
+ */
+#define trb_spsc_is_full(NAME)\
+    ((size_t)(_trb_spsc_stage_pos(NAME) - _trb_spsc_head_acq(NAME)) == _trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Get the total capacity of the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_spsc_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Push an element into the buffer (producer only)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_spsc_push(NAME, VALUE_PTR)\
+    ((trb_spsc_push_local(NAME, VALUE_PTR) != 0)?(-1):\
+    (trb_spsc_flush(NAME), (0)))
+
+/**
+ * \brief   Stage an element without publishing it (producer only)
+ *
+ *          The new tail is published once TRB_SPSC_BATCH elements are
+ *          staged, when the buffer is found full, or by trb_spsc_flush.
+ *          trb_spsc_push and trb_spsc_push_wait (tiny_rb_wait.h) also
+ *          publish everything staged before their own element.
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full (staged elements have been published)
+ */
+#define trb_spsc_push_local(NAME, VALUE_PTR)\
+    (!_trb_spsc_writable(NAME)?(trb_spsc_flush(NAME), (-1)):\
+    (memcpy(&_trb_##NAME##_buf.buf[_trb_spsc_stage_pos(NAME) & _trb_##NAME##_buf.mask], VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0])),\
+    (++_trb_##NAME##_buf.staged >= TRB_SPSC_BATCH)?(trb_spsc_flush(NAME), (0)):(0)))
+
+/**
+ * \brief   Publish all staged elements with one release store (producer only)
+ *
+ * \param   [in] NAME      Buffer name
+ */
+#define trb_spsc_flush(NAME)\
+    ((void)(_trb_##NAME##_buf.staged &&\
+    (atomic_store_explicit(&_trb_##NAME##_buf.tail, _trb_spsc_stage_pos(NAME), memory_order_release),\
+    _trb_##NAME##_buf.staged = 0, _TRB_SPSC_WAKE(NAME, not_empty), 1)))
+
+/**
+ * \brief   Pop an element from the buffer (consumer only)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_spsc_pop(NAME, VALUE_PTR)\
+    (!_trb_spsc_readable(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_spsc_head_own(NAME) & _trb_##NAME##_buf.mask], sizeof(_trb_##NAME##_buf.buf[0])),\
+    atomic_store_explicit(&_trb_##NAME##_buf.head, _trb_spsc_head_own(NAME) + 1, memory_order_release),\
+    _TRB_SPSC_WAKE(NAME, not_full), (0)))
+
+/**
+ * \brief   Peek at the front element without removing it (consumer only)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the element will be copied
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_spsc_peek(NAME, VALUE_PTR)\
+    (!_trb_spsc_readable(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_spsc_head_own(NAME) & _trb_##NAME##_buf.mask], sizeof(_trb_##NAME##_buf.buf[0])),\
+    (0)))
+
+#endif /* __TINY_RB_SPSC_H__ */
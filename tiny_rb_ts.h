@@ -0,0 +1,238 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_ts.h
+ *
+ * \brief Timestamped ring buffer with time-range queries (non-thread-safe)
+ *        Every element carries a timestamp in a parallel array.
+ *        Timestamps must be pushed in non-decreasing order, so the live
+ *        elements stay sorted by time across the wrap and a time range is
+ *        found with two binary searches instead of a linear scan.
+ *
+ *        The buffer has the TRB_RB_DEFINE fields, so the read-only macros
+ *        (trb_size, trb_at, trb_spans, ...) work on it, but it must be
+ *        modified through trb_ts_* only.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_TS_H__
+#define __TINY_RB_TS_H__
+
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Timestamp type (any unsigned integer type)
+ */
+#ifndef TRB_TS_T
+#define TRB_TS_T uint64_t
+#endif
+
+/**
+ * \brief   Result of trb_range_by_time
+ *          Elements first .. first + count - 1 (0 = oldest) are in range,
+ *          read them with trb_at(NAME, first + k).
+ */
+typedef struct {
+    size_t first;
+    size_t count;
+} trb_ts_span_t;
+
+/**
+ * \brief   Declare a global timestamped ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer
+ */
+#define TRB_TS_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        size_t   capacity;\
+        size_t   head;\
+        size_t   tail;\
+        size_t   count;\
+        TRB_TS_T stamp[CAPACITY];\
+        TYPE     buf[CAPACITY];\
+    } _trb_##NAME##_buf = {\
+        .capacity = CAPACITY,\
+        .head = 0,\
+        .tail = 0,\
+        .count = 0\
+    }
+
+/**
+ * \brief   Declare a static timestamped ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer
+ */
+#define TRB_TS_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_TS_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global timestamped ring buffer
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Capacity used in the definition
+ */
+#define TRB_TS_IMPORT(TYPE, NAME, CAPACITY)\
+    extern struct {\
+        size_t   capacity;\
+        size_t   head;\
+        size_t   tail;\
+        size_t   count;\
+        TRB_TS_T stamp[CAPACITY];\
+        TYPE     buf[CAPACITY];\
+    } _trb_##NAME##_buf
+
+/* Index of the first live element whose stamp is >= t (or > t if strict) */
+static inline size_t _trb_ts_bound(const TRB_TS_T *stamp, size_t capacity, size_t head,
+                                   size_t count, TRB_TS_T t, int strict)
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        TRB_TS_T s = stamp[_trb_wrap(head + mid, capacity)];
+
+        if (strict ? (s <= t) : (s < t)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static inline size_t _trb_ts_range(const TRB_TS_T *stamp, size_t capacity, size_t head,
+                                   size_t count, TRB_TS_T t0, TRB_TS_T t1, trb_ts_span_t *span)
+{
+    size_t first = _trb_ts_bound(stamp, capacity, head, count, t0, 0);
+    size_t last = (t1 < t0) ? first : _trb_ts_bound(stamp, capacity, head, count, t1, 1);
+
+    span->first = first;
+    span->count = last - first;
+    return span->count;
+}
+
+/**
+ * \brief   Append an element and its timestamp, evaluated once by the caller
+ *
+ * \param   [in]     buf       Element storage
+ * \param   [in]     stamp     Timestamp storage
+ * \param   [in]     capacity  Number of slots
+ * \param   [in,out] head      Index of the oldest element
+ * \param   [in,out] tail      Index of the next free slot
+ * \param   [in,out] count     Number of live elements
+ * \param   [in]     value     Element to copy in
+ * \param   [in]     esize     Size of one element in bytes
+ * \param   [in]     ts        Timestamp of the element
+ * \param   [in]     force     Drop the oldest element instead of failing when full
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full (without force), or ts older than the newest element
+ */
+static inline int _trb_ts_push(void *buf, TRB_TS_T *stamp, size_t capacity,
+                               size_t *head, size_t *tail, size_t *count,
+                               const void *value, size_t esize, TRB_TS_T ts, int force)
+{
+    if (*count > 0 && ts < stamp[(*tail == 0) ? (capacity - 1) : (*tail - 1)]) {
+        return -1;
+    }
+    if (*count == capacity) {
+        if (!force) {
+            return -1;
+        }
+        *head = _trb_wrap(*head + 1, capacity);
+        (*count)--;
+    }
+    memcpy((char *)buf + *tail * esize, value, esize);
+    stamp[*tail] = ts;
+    *tail = _trb_wrap(*tail + 1, capacity);
+    (*count)++;
+    return 0;
+}
+
+#define _trb_ts_push_args(NAME)\
+    _trb_##NAME##_buf.buf, _trb_##NAME##_buf.stamp, _trb_##NAME##_buf.capacity,\
+    &_trb_##NAME##_buf.head, &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.count
+
+/**
+ * \brief   Get the timestamp of the i-th oldest element
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] I         Index from the oldest element (must be < trb_size)
+ *
+ * \return  Timestamp (TRB_TS_T)
+ */
+#define trb_ts_stamp(NAME, I)\
+    (_trb_##NAME##_buf.stamp[_trb_wrap(_trb_##NAME##_buf.head + (size_t)(I), _trb_##NAME##_buf.capacity)])
+
+/**
+ * \brief   Push an element with its timestamp
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ * \param   [in] TS        Timestamp, not older than the newest element
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full, or TS older than the newest element
+ */
+#define trb_ts_push(NAME, VALUE_PTR, TS)\
+    _trb_ts_push(_trb_ts_push_args(NAME), VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]), (TRB_TS_T)(TS), 0)
+
+/**
+ * \brief   Push an element with its timestamp, dropping the oldest one if full
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ * \param   [in] TS        Timestamp, not older than the newest element
+ *
+ * \return  - (0)  Success
+ *          - (-1) TS older than the newest element (nothing is dropped)
+ */
+#define trb_ts_force_push(NAME, VALUE_PTR, TS)\
+    _trb_ts_push(_trb_ts_push_args(NAME), VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]), (TRB_TS_T)(TS), 1)
+
+/**
+ * \brief   Pop the oldest element
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_ts_pop(NAME, VALUE_PTR)\
+    (trb_is_empty(NAME)?(-1):\
+    (memcpy(VALUE_PTR, &_trb_##NAME##_buf.buf[_trb_##NAME##_buf.head], sizeof(_trb_##NAME##_buf.buf[0])),\
+    _trb_##NAME##_buf.head = _trb_wrap(_trb_##NAME##_buf.head + 1, _trb_##NAME##_buf.capacity),\
+    _trb_##NAME##_buf.count--, (0)))
+
+/**
+ * \brief   Find the elements with T0 <= timestamp <= T1 in O(log N)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [in]  T0        Start of the range (inclusive)
+ * \param   [in]  T1        End of the range (inclusive)
+ * \param   [out] SPAN_PTR  trb_ts_span_t receiving the first index and count
+ *
+ * \return  Number of elements in range (size_t)
+ */
+#define trb_range_by_time(NAME, T0, T1, SPAN_PTR)\
+    _trb_ts_range(_trb_##NAME##_buf.stamp, _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.head,\
+                  _trb_##NAME##_buf.count, (TRB_TS_T)(T0), (TRB_TS_T)(T1), SPAN_PTR)
+
+#endif /* __TINY_RB_TS_H__ */
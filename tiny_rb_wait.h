@@ -0,0 +1,353 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_wait.h
+ *
+ * \brief Blocking and timed-wait push/pop for SPSC ring buffers
+ *        Callers spin briefly, then park on a futex (Linux), WaitOnAddress
+ *        (Windows) or user-supplied hooks (RTOS). Including this header
+ *        defines TRB_WAIT, which embeds the wait channels in every SPSC
+ *        buffer, so plain trb_spsc_push/flush/pop wake parked threads too.
+ *        The other side only issues a wake-up when a waiter is registered.
+ *        Waiters pay for the store/load ordering with a process-wide barrier
+ *        (membarrier on Linux, FlushProcessWriteBuffers on Windows), so the
+ *        uncontended push/pop only adds one load and a compiler barrier;
+ *        without one (user hooks, or membarrier refused) both sides fence.
+ *
+ *        To use user hooks, define before including this header:
+ *          TRB_WAIT_PARK(addr, expected, timeout_ms)  block while *addr ==
+ *                                                     expected, or until the
+ *                                                     timeout (-1: forever)
+ *          TRB_WAIT_WAKE(addr)                        wake all parked waiters
+ *          TRB_WAIT_NOW_MS()                          monotonic milliseconds
+ *        A semaphore works as a backing primitive: PARK takes it with the
+ *        timeout, WAKE gives it; spurious wake-ups are tolerated.
+ *
+ *        On Linux the futex backend needs syscall() and clock_gettime():
+ *        build with -std=gnu11 or define _GNU_SOURCE before any include.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_WAIT_H__
+#define __TINY_RB_WAIT_H__
+
+#if defined(__TINY_RB_SPSC_H__) && !defined(TRB_WAIT)
+#error "tiny_rb_wait.h: include it before tiny_rb_spsc.h, or define TRB_WAIT globally"
+#endif
+#ifndef TRB_WAIT
+#define TRB_WAIT
+#endif
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/**
+ * \brief   Timeout value that waits forever
+ */
+#define TRB_WAIT_FOREVER (-1L)
+
+/**
+ * \brief   Number of non-blocking attempts before parking
+ */
+#ifndef TRB_WAIT_SPIN
+#define TRB_WAIT_SPIN 128
+#endif
+
+#if defined(TRB_WAIT_PARK)
+
+#ifndef TRB_WAIT_WAKE
+#error "TRB_WAIT_PARK requires TRB_WAIT_WAKE"
+#endif
+#ifndef TRB_WAIT_NOW_MS
+#error "TRB_WAIT_PARK requires TRB_WAIT_NOW_MS"
+#endif
+
+#define _trb_wait_now_ms()                  ((uint64_t)TRB_WAIT_NOW_MS())
+#define _trb_wait_park(ADDR, EXPECTED, MS)  TRB_WAIT_PARK(ADDR, EXPECTED, MS)
+#define _trb_wait_wake(ADDR)                TRB_WAIT_WAKE(ADDR)
+#define _trb_wait_asym()                    (0)
+#define _trb_wait_barrier()                 ((void)0)
+
+#elif defined(__linux__)
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+static inline uint64_t _trb_wait_now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+static inline void _trb_wait_park(atomic_uint *addr, unsigned expected, long timeout_ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+    syscall(SYS_futex, (unsigned *)addr, FUTEX_WAIT_PRIVATE, expected,
+            timeout_ms < 0 ? NULL : &ts, NULL, 0);
+}
+
+static inline void _trb_wait_wake(atomic_uint *addr)
+{
+    syscall(SYS_futex, (unsigned *)addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/* Register for expedited membarrier on first use; 1 if the kernel allows it */
+static inline int _trb_wait_asym(void)
+{
+    static atomic_int state;    /* 0: not asked yet, 1: available, 2: refused */
+    int s = atomic_load_explicit(&state, memory_order_relaxed);
+
+    if (s == 0) {
+        s = syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0 ? 1 : 2;
+        atomic_store_explicit(&state, s, memory_order_relaxed);
+    }
+    return s == 1;
+}
+
+static inline void _trb_wait_barrier(void)
+{
+    syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+}
+
+#elif defined(_WIN32)
+
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+
+static inline uint64_t _trb_wait_now_ms(void)
+{
+    return (uint64_t)GetTickCount64();
+}
+
+static inline void _trb_wait_park(atomic_uint *addr, unsigned expected, long timeout_ms)
+{
+    WaitOnAddress((volatile VOID *)addr, &expected, sizeof(expected),
+                  timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms);
+}
+
+static inline void _trb_wait_wake(atomic_uint *addr)
+{
+    WakeByAddressAll((PVOID)addr);
+}
+
+#define _trb_wait_asym()                    (1)
+#define _trb_wait_barrier()                 FlushProcessWriteBuffers()
+
+#else
+#error "tiny_rb_wait.h: no wait primitive for this platform, define TRB_WAIT_PARK/TRB_WAIT_WAKE/TRB_WAIT_NOW_MS"
+#endif
+
+/**
+ * \brief   One direction of waiting (consumers for data, producers for space)
+ */
+typedef struct {
+    atomic_uint epoch;      /**< Bumped on every wake-up, parked on by waiters */
+    atomic_uint waiters;    /**< Number of registered waiters */
+} trb_wait_chan_t;
+
+/**
+ * \brief   Store/load fence of the signalling side; only keeps compiler order
+ *          when the waiting side issues the process-wide barrier
+ */
+static inline void _trb_wait_fence_light(void)
+{
+    if (_trb_wait_asym()) {
+        atomic_signal_fence(memory_order_seq_cst);
+    } else {
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+}
+
+/**
+ * \brief   Store/load fence of the waiting side, run once per park
+ */
+static inline void _trb_wait_fence_heavy(void)
+{
+    if (_trb_wait_asym()) {
+        _trb_wait_barrier();
+    } else {
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+}
+
+/**
+ * \brief   Wake the other side if it registered as a waiter on ch
+ *
+ *          The light fence pairs with the heavy one in _trb_wait_until:
+ *          either this side sees the registered waiter, or the waiter sees
+ *          the index just published.
+ */
+static inline void _trb_wait_signal(trb_wait_chan_t *ch)
+{
+    _trb_wait_fence_light();
+    if (atomic_load_explicit(&ch->waiters, memory_order_relaxed) != 0) {
+        atomic_fetch_add_explicit(&ch->epoch, 1, memory_order_release);
+        _trb_wait_wake(&ch->epoch);
+    }
+}
+
+#include "tiny_rb_spsc.h"
+
+/* Type-erased view of one SPSC buffer plus the element being moved */
+typedef struct {
+    atomic_size_t *head;
+    atomic_size_t *tail;
+    size_t        *staged;
+    size_t         capacity;
+    size_t         mask;
+    unsigned char *buf;
+    size_t         esize;
+    void          *value;
+} _trb_spsc_ctx_t;
+
+#define _TRB_SPSC_CTX(NAME, VALUE_PTR)\
+    (&(_trb_spsc_ctx_t){\
+        &_trb_##NAME##_buf.head, &_trb_##NAME##_buf.tail, &_trb_##NAME##_buf.staged,\
+        _trb_##NAME##_buf.capacity, _trb_##NAME##_buf.mask,\
+        (unsigned char *)_trb_##NAME##_buf.buf, sizeof(_trb_##NAME##_buf.buf[0]),\
+        (void *)(VALUE_PTR)\
+    })
+
+static inline int _trb_spsc_try_push(const _trb_spsc_ctx_t *c)
+{
+    size_t tail = atomic_load_explicit(c->tail, memory_order_relaxed);
+
+    if (tail - atomic_load_explicit(c->head, memory_order_acquire) == c->capacity) {
+        return -1;
+    }
+    memcpy(c->buf + (tail & c->mask) * c->esize, c->value, c->esize);
+    atomic_store_explicit(c->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+static inline int _trb_spsc_try_pop(const _trb_spsc_ctx_t *c)
+{
+    size_t head = atomic_load_explicit(c->head, memory_order_relaxed);
+
+    if (head == atomic_load_explicit(c->tail, memory_order_acquire)) {
+        return -1;
+    }
+    memcpy(c->value, c->buf + (head & c->mask) * c->esize, c->esize);
+    atomic_store_explicit(c->head, head + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * \brief   Retry op until it succeeds, spinning first and then parking on ch
+ *
+ * \return  - (0)  op succeeded
+ *          - (-1) Timed out
+ */
+static inline int _trb_wait_until(trb_wait_chan_t *ch,
+                                  int (*op)(const _trb_spsc_ctx_t *),
+                                  const _trb_spsc_ctx_t *ctx, long timeout_ms)
+{
+    uint64_t deadline = 0;
+    long remaining = timeout_ms;
+    int i;
+
+    for (i = 0; i < TRB_WAIT_SPIN; i++) {
+        if (op(ctx) == 0) {
+            return 0;
+        }
+    }
+    if (timeout_ms == 0) {
+        return -1;
+    }
+    if (timeout_ms > 0) {
+        deadline = _trb_wait_now_ms() + (uint64_t)timeout_ms;
+    }
+    for (;;) {
+        unsigned epoch = atomic_load_explicit(&ch->epoch, memory_order_acquire);
+
+        atomic_fetch_add_explicit(&ch->waiters, 1, memory_order_relaxed);
+        _trb_wait_fence_heavy();
+        if (op(ctx) == 0) {
+            atomic_fetch_sub_explicit(&ch->waiters, 1, memory_order_relaxed);
+            return 0;
+        }
+        if (timeout_ms > 0) {
+            uint64_t now = _trb_wait_now_ms();
+
+            if (now >= deadline) {
+                atomic_fetch_sub_explicit(&ch->waiters, 1, memory_order_relaxed);
+                return -1;
+            }
+            remaining = (long)(deadline - now);
+        }
+        _trb_wait_park(&ch->epoch, epoch, remaining);
+        atomic_fetch_sub_explicit(&ch->waiters, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * \brief   Publish elements staged by trb_spsc_push_local, then push one
+ *          element waiting for space; the staged elements stay ahead of it
+ */
+static inline int _trb_spsc_push_wait(const _trb_spsc_ctx_t *c, trb_wait_chan_t *not_full,
+                                      trb_wait_chan_t *not_empty, long timeout_ms)
+{
+    if (*c->staged != 0) {
+        atomic_store_explicit(c->tail, atomic_load_explicit(c->tail, memory_order_relaxed) + *c->staged,
+                              memory_order_release);
+        *c->staged = 0;
+        _trb_wait_signal(not_empty);
+    }
+    if (_trb_wait_until(not_full, _trb_spsc_try_push, c, timeout_ms) != 0) {
+        return -1;
+    }
+    _trb_wait_signal(not_empty);
+    return 0;
+}
+
+/**
+ * \brief   Push an element, waiting up to TIMEOUT_MS for space (producer only)
+ *
+ *          Elements staged by trb_spsc_push_local are published first.
+ *
+ * \param   [in] NAME       Buffer name
+ * \param   [in] VALUE_PTR  Pointer to the element to be pushed
+ * \param   [in] TIMEOUT_MS Milliseconds to wait, 0 never, TRB_WAIT_FOREVER
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer still full after the timeout
+ */
+#define trb_spsc_push_wait(NAME, VALUE_PTR, TIMEOUT_MS)\
+    _trb_spsc_push_wait(_TRB_SPSC_CTX(NAME, VALUE_PTR), &_trb_##NAME##_buf.not_full,\
+                        &_trb_##NAME##_buf.not_empty, TIMEOUT_MS)
+
+/**
+ * \brief   Pop an element, waiting up to TIMEOUT_MS for data (consumer only)
+ *
+ * \param   [in]  NAME       Buffer name
+ * \param   [out] VALUE_PTR  Pointer where the popped element will be stored
+ * \param   [in]  TIMEOUT_MS Milliseconds to wait, 0 never, TRB_WAIT_FOREVER
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer still empty after the timeout
+ */
+#define trb_spsc_pop_wait(NAME, VALUE_PTR, TIMEOUT_MS)\
+    ((_trb_wait_until(&_trb_##NAME##_buf.not_empty, _trb_spsc_try_pop,\
+                      _TRB_SPSC_CTX(NAME, VALUE_PTR), TIMEOUT_MS) == 0)?\
+    (_trb_wait_signal(&_trb_##NAME##_buf.not_full), (0)):(-1))
+
+#endif /* __TINY_RB_WAIT_H__ */
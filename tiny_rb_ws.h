@@ -0,0 +1,246 @@
+/******************************************************************************/
+/**
+ * \file  tiny_rb_ws.h
+ *
+ * \brief Lock-free work-stealing deque (Chase-Lev, C11 atomics)
+ *        One owner thread pushes and pops at the bottom in LIFO order using
+ *        plain relaxed loads/stores (plus one fence in pop). Any number of
+ *        thief threads take the oldest element at the top with a CAS.
+ *        The capacity is fixed (static storage), so push fails when full
+ *        instead of growing the array.
+ *
+ * \author    Aym <aymhzy@163.com>
+ * \date      2026-01-09
+ * \version   1.0.0
+ *
+ * \copyright
+ * Copyright 2026
+ *
+ * The License of this software follows MIT, See the LICENSE for more details:
+ * https://opensource.org/license/mit
+ */
+
+#ifndef __TINY_RB_WS_H__
+#define __TINY_RB_WS_H__
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "tiny_rb.h"
+
+/*
+ * top and bottom are free-running counters; the elements live at
+ * [top, bottom). bottom may briefly sit one below top while the owner
+ * pops from an empty deque, so differences are compared as signed values.
+ */
+
+/**
+ * \brief   Declare a global work-stealing deque
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_WS_DEFINE(TYPE, NAME, CAPACITY)\
+    struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t top;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t bottom;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        TYPE   buf[_TRB_POW2_CHECK(CAPACITY)];\
+    } _trb_##NAME##_buf = {\
+        .top = 0,\
+        .bottom = 0,\
+        .capacity = CAPACITY,\
+        .mask = (CAPACITY) - 1\
+    }
+
+/**
+ * \brief   Declare a static work-stealing deque
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ * \param   [in] CAPACITY  Maximum capacity of the buffer (power of two)
+ */
+#define TRB_WS_DEFINE_STATIC(TYPE, NAME, CAPACITY)\
+    static TRB_WS_DEFINE(TYPE, NAME, CAPACITY)
+
+/**
+ * \brief   Import a global work-stealing deque
+ *
+ * \param   [in] TYPE      Data type of the buffer elements
+ * \param   [in] NAME      Name of the buffer (used in macro expansions)
+ */
+#define TRB_WS_IMPORT(TYPE, NAME)\
+    extern struct {\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t top;\
+        _Alignas(TRB_CACHELINE_SIZE) atomic_size_t bottom;\
+        _Alignas(TRB_CACHELINE_SIZE) size_t capacity;\
+        size_t mask;\
+        TYPE   buf[];\
+    } _trb_##NAME##_buf
+
+/**
+ * \brief   Push an element at the bottom (owner only)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+static inline int _trb_ws_push(atomic_size_t *top, atomic_size_t *bottom, size_t mask,
+                               char *buf, const void *value, size_t esize)
+{
+    size_t b = atomic_load_explicit(bottom, memory_order_relaxed);
+    size_t t = atomic_load_explicit(top, memory_order_acquire);
+
+    if (b - t > mask) {
+        return -1;
+    }
+    memcpy(buf + (b & mask) * esize, value, esize);
+    atomic_store_explicit(bottom, b + 1, memory_order_release);
+    return 0;
+}
+
+/**
+ * \brief   Pop the newest element from the bottom (owner only)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty, or the last element was stolen
+ */
+static inline int _trb_ws_pop(atomic_size_t *top, atomic_size_t *bottom, size_t mask,
+                              const char *buf, void *value, size_t esize)
+{
+    size_t b = atomic_load_explicit(bottom, memory_order_relaxed) - 1;
+    size_t t;
+    int ret = 0;
+
+    atomic_store_explicit(bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    t = atomic_load_explicit(top, memory_order_relaxed);
+
+    if ((intptr_t)(b - t) < 0) {
+        atomic_store_explicit(bottom, b + 1, memory_order_relaxed);
+        return -1;
+    }
+    memcpy(value, buf + (b & mask) * esize, esize);
+    if (b == t) {
+        /* Last element: race the thieves for it */
+        if (!atomic_compare_exchange_strong_explicit(top, &t, t + 1,
+                memory_order_seq_cst, memory_order_relaxed)) {
+            ret = -1;
+        }
+        atomic_store_explicit(bottom, b + 1, memory_order_relaxed);
+    }
+    return ret;
+}
+
+/**
+ * \brief   Take the oldest element from the top (any thread)
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ *          - (-2) Lost the race to another thief or the owner; retry
+ */
+static inline int _trb_ws_steal(atomic_size_t *top, atomic_size_t *bottom, size_t mask,
+                                const char *buf, void *value, size_t esize)
+{
+    size_t t = atomic_load_explicit(top, memory_order_acquire);
+    size_t b;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    b = atomic_load_explicit(bottom, memory_order_acquire);
+
+    if ((intptr_t)(b - t) <= 0) {
+        return -1;
+    }
+    memcpy(value, buf + (t & mask) * esize, esize);
+    if (!atomic_compare_exchange_strong_explicit(top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed)) {
+        return -2;
+    }
+    return 0;
+}
+
+/* Element count clamped to 0 while an owner pop is in flight */
+static inline size_t _trb_ws_size(atomic_size_t *top, atomic_size_t *bottom)
+{
+    size_t b = atomic_load_explicit(bottom, memory_order_acquire);
+    size_t t = atomic_load_explicit(top, memory_order_acquire);
+
+    return ((intptr_t)(b - t) > 0) ? (b - t) : 0;
+}
+
+/* Arguments shared by push, pop and steal */
+#define _trb_ws_args(NAME)\
+    &_trb_##NAME##_buf.top, &_trb_##NAME##_buf.bottom, _trb_##NAME##_buf.mask,\
+    (char *)_trb_##NAME##_buf.buf
+
+/**
+ * \brief   Get the number of elements currently in the buffer (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Number of elements (size_t)
+ */
+#define trb_ws_size(NAME)\
+    _trb_ws_size(&_trb_##NAME##_buf.top, &_trb_##NAME##_buf.bottom)
+
+/**
+ * \brief   Check if the buffer is empty (snapshot)
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  - (1): Empty
+ *          - (0): Not empty
+ */
+#define trb_ws_is_empty(NAME)\
+    (trb_ws_size(NAME) == 0)
+
+/**
+ * \brief   Get the total capacity of the buffer
+ *
+ * \param   [in] NAME      Buffer name
+ *
+ * \return  Total capacity (size_t)
+ */
+#define trb_ws_capacity(NAME)\
+    (_trb_##NAME##_buf.capacity)
+
+/**
+ * \brief   Push an element at the bottom (owner thread only)
+ *
+ * \param   [in] NAME      Buffer name
+ * \param   [in] VALUE_PTR Pointer to the element to be pushed
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer full
+ */
+#define trb_ws_push(NAME, VALUE_PTR)\
+    _trb_ws_push(_trb_ws_args(NAME), VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]))
+
+/**
+ * \brief   Pop the most recently pushed element (owner thread only)
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the popped element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ */
+#define trb_ws_pop(NAME, VALUE_PTR)\
+    _trb_ws_pop(_trb_ws_args(NAME), VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]))
+
+/**
+ * \brief   Steal the oldest element (any thread)
+ *          *VALUE_PTR is only valid when 0 is returned.
+ *
+ * \param   [in]  NAME      Buffer name
+ * \param   [out] VALUE_PTR Pointer where the stolen element will be stored
+ *
+ * \return  - (0)  Success
+ *          - (-1) Buffer empty
+ *          - (-2) Lost a race with another thread; retry or pick another victim
+ */
+#define trb_ws_steal(NAME, VALUE_PTR)\
+    _trb_ws_steal(_trb_ws_args(NAME), VALUE_PTR, sizeof(_trb_##NAME##_buf.buf[0]))
+
+#endif /* __TINY_RB_WS_H__ */